@@ -109,6 +109,11 @@ namespace pix
 			return pumpFunction_;
 		}
 
+		bool AbstractInputPump::HasCustomPumpFunction() const
+		{
+			return pumpFunction_ != DefaultPumpFunction;
+		}
+
 		VirtualAxis& AbstractInputPump::GetVirtualAxis() const
 		{
 			return *virtualAxis_;
@@ -126,18 +126,22 @@ namespace pix
 
 		PumpFunction GetPumpFunction() const;
 
+		// Returns true if a pump function other than DefaultPumpFunction() is set
+		bool HasCustomPumpFunction() const;
+
 		// Philosophy: Returns a non-const reference because the pump does not own the bound VirtualAxis.
 		// Constness of the pump does not restrict mutation of externally owned objects.
 		VirtualAxis& GetVirtualAxis() const; 
 
 		int GetCachedAxisID() const;
 
-	private:
-
 		// Returns the value with the biggest magnitude, so the biggest contributor wins.
 		// On equal magnitude, the source value wins (later pumps override earlier ones).
+		// Public so that batched pump loops can apply it directly instead of through the function pointer.
 		static float DefaultPumpFunction(float sourceState, float axisState);
 
+	private:
+
 		PumpFunction pumpFunction_ = DefaultPumpFunction;
 		VirtualAxis* virtualAxis_ = nullptr;
 		int cachedAxisID_ = -1;
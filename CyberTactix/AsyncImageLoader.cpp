@@ -0,0 +1,283 @@
+#include "AsyncImageLoader.h"
+#include <algorithm>
+#include <SDL_image.h>
+#include <SDL_timer.h>
+#include "ErrorLogger.h"
+#include "PixMath.h"
+
+namespace pix
+{
+
+	AsyncImageLoader::AsyncImageLoader(int workerCount)
+	{
+		workerCount = GetClamped(workerCount, 1, 16);
+
+		mutex_ = SDL_CreateMutex();
+		decodeCondition_ = SDL_CreateCond();
+
+		if (!mutex_ || !decodeCondition_)
+		{
+			ErrorLogger::Get().LogSDLError("AsyncImageLoader::AsyncImageLoader() - SDL_CreateMutex()/SDL_CreateCond() failure");
+			return;
+		}
+
+		for (int i = 0; i < workerCount; i++)
+		{
+			SDL_Thread* worker = SDL_CreateThread(RunWorker, "PixImageDecoder", this);
+
+			if (!worker)
+			{
+				ErrorLogger::Get().LogSDLError("AsyncImageLoader::AsyncImageLoader() - SDL_CreateThread() failure");
+				break;
+			}
+
+			workers_.push_back(worker);
+		}
+	}
+
+	AsyncImageLoader::~AsyncImageLoader()
+	{
+		if (mutex_)
+		{
+			SDL_LockMutex(mutex_);
+			isStopping_ = true;
+			SDL_CondBroadcast(decodeCondition_);
+			SDL_UnlockMutex(mutex_);
+		}
+
+		const int workerCount = workers_.size();
+
+		for (int i = 0; i < workerCount; i++)
+			SDL_WaitThread(workers_[i], nullptr);
+
+		// Workers have finished, so the queues are no longer shared
+		const int uploadCount = uploadQueue_.size();
+
+		for (int i = 0; i < uploadCount; i++)
+			SDL_FreeSurface(uploadQueue_[i].Surface);
+
+		SDL_DestroyCond(decodeCondition_);
+		SDL_DestroyMutex(mutex_);
+	}
+
+	int AsyncImageLoader::Load(ImageTexture& texture, const std::string& imagePath)
+	{
+		if (workers_.empty())
+		{
+			ErrorLogger::Get().LogError("AsyncImageLoader::Load() failure", "No worker threads available!");
+			return 0;
+		}
+
+		Request request;
+		request.Texture = &texture;
+		request.ImagePath = imagePath;
+
+		SDL_LockMutex(mutex_);
+
+		request.ID = nextRequestID_++;
+		if (nextRequestID_ <= 0) nextRequestID_ = 1; // Wrap around, IDs stay positive
+
+		const int requestID = request.ID;
+		decodeQueue_.push_back(request);
+
+		SDL_CondSignal(decodeCondition_);
+		SDL_UnlockMutex(mutex_);
+
+		return requestID;
+	}
+
+	bool AsyncImageLoader::Cancel(int requestID)
+	{
+		bool isCancelled = false;
+
+		SDL_LockMutex(mutex_);
+
+		for (auto it = decodeQueue_.begin(); it != decodeQueue_.end(); ++it)
+		{
+			if (it->ID == requestID)
+			{
+				decodeQueue_.erase(it);
+				isCancelled = true;
+				break;
+			}
+		}
+
+		if (!isCancelled)
+		{
+			for (auto it = uploadQueue_.begin(); it != uploadQueue_.end(); ++it)
+			{
+				if (it->ID == requestID)
+				{
+					SDL_FreeSurface(it->Surface);
+					uploadQueue_.erase(it);
+					isCancelled = true;
+					break;
+				}
+			}
+		}
+
+		// A request being decoded right now is dropped by its worker once decoding has finished. A repeated cancel is not pending anymore.
+		if (!isCancelled && std::find(decodingIDs_.begin(), decodingIDs_.end(), requestID) != decodingIDs_.end() &&
+			std::find(cancelledIDs_.begin(), cancelledIDs_.end(), requestID) == cancelledIDs_.end())
+		{
+			cancelledIDs_.push_back(requestID);
+			isCancelled = true;
+		}
+
+		SDL_UnlockMutex(mutex_);
+
+		return isCancelled;
+	}
+
+	void AsyncImageLoader::CancelAll()
+	{
+		SDL_LockMutex(mutex_);
+
+		decodeQueue_.clear();
+
+		const int uploadCount = uploadQueue_.size();
+
+		for (int i = 0; i < uploadCount; i++)
+			SDL_FreeSurface(uploadQueue_[i].Surface);
+
+		uploadQueue_.clear();
+
+		cancelledIDs_ = decodingIDs_;
+
+		SDL_UnlockMutex(mutex_);
+	}
+
+	int AsyncImageLoader::ProcessUploads(double timeBudget)
+	{
+		const Uint64 startCounter = SDL_GetPerformanceCounter();
+		const double countsPerMillisecond = SDL_GetPerformanceFrequency() / 1000.0;
+
+		int completedCount = 0;
+
+		while (true)
+		{
+			Request request;
+
+			SDL_LockMutex(mutex_);
+
+			if (uploadQueue_.empty())
+			{
+				SDL_UnlockMutex(mutex_);
+				break;
+			}
+
+			request = uploadQueue_.front();
+			uploadQueue_.pop_front();
+
+			SDL_UnlockMutex(mutex_);
+
+			// The upload itself runs unlocked, so workers can keep publishing decoded images
+			if (request.Surface)
+			{
+				request.Texture->Reload(request.Surface);
+				SDL_FreeSurface(request.Surface);
+			}
+			else
+			{
+				ErrorLogger::Get().LogError("AsyncImageLoader::ProcessUploads() - IMG_Load() failure", request.ImagePath + ": " + request.ErrorMessage);
+			}
+
+			completedCount++;
+
+			const double elapsedTime = (SDL_GetPerformanceCounter() - startCounter) / countsPerMillisecond;
+			if (elapsedTime >= timeBudget) break;
+		}
+
+		return completedCount;
+	}
+
+	bool AsyncImageLoader::IsPending(int requestID) const
+	{
+		auto hasRequestID = [requestID](const Request& request) { return request.ID == requestID; };
+
+		SDL_LockMutex(mutex_);
+
+		bool isPending = std::find_if(decodeQueue_.begin(), decodeQueue_.end(), hasRequestID) != decodeQueue_.end() ||
+			std::find_if(uploadQueue_.begin(), uploadQueue_.end(), hasRequestID) != uploadQueue_.end();
+
+		if (!isPending && std::find(decodingIDs_.begin(), decodingIDs_.end(), requestID) != decodingIDs_.end())
+			isPending = std::find(cancelledIDs_.begin(), cancelledIDs_.end(), requestID) == cancelledIDs_.end();
+
+		SDL_UnlockMutex(mutex_);
+
+		return isPending;
+	}
+
+	int AsyncImageLoader::GetPendingCount() const
+	{
+		SDL_LockMutex(mutex_);
+
+		const int pendingCount = decodeQueue_.size() + uploadQueue_.size() + decodingIDs_.size() - cancelledIDs_.size();
+
+		SDL_UnlockMutex(mutex_);
+
+		return pendingCount;
+	}
+
+	bool AsyncImageLoader::IsIdle() const
+	{
+		return GetPendingCount() == 0;
+	}
+
+	int AsyncImageLoader::GetWorkerCount() const
+	{
+		return workers_.size();
+	}
+
+
+
+	int SDLCALL AsyncImageLoader::RunWorker(void* loader)
+	{
+		ErrorLogger::Get().InstallThreadCrashHandler();
+		static_cast<AsyncImageLoader*>(loader)->RunDecodeLoop();
+		return 0;
+	}
+
+	void AsyncImageLoader::RunDecodeLoop()
+	{
+		SDL_LockMutex(mutex_);
+
+		while (true)
+		{
+			while (decodeQueue_.empty() && !isStopping_)
+				SDL_CondWait(decodeCondition_, mutex_);
+
+			if (isStopping_) break;
+
+			Request request = decodeQueue_.front();
+			decodeQueue_.pop_front();
+			decodingIDs_.push_back(request.ID);
+
+			SDL_UnlockMutex(mutex_);
+
+			// Decode without holding the lock. SDL errors are thread-local, so the message is captured here.
+			request.Surface = IMG_Load(request.ImagePath.c_str());
+			if (!request.Surface)
+				request.ErrorMessage = SDL_GetError();
+
+			SDL_LockMutex(mutex_);
+
+			decodingIDs_.erase(std::find(decodingIDs_.begin(), decodingIDs_.end(), request.ID));
+
+			auto cancelled = std::find(cancelledIDs_.begin(), cancelledIDs_.end(), request.ID);
+
+			if (cancelled != cancelledIDs_.end())
+			{
+				cancelledIDs_.erase(cancelled);
+				SDL_FreeSurface(request.Surface);
+			}
+			else
+			{
+				uploadQueue_.push_back(request);
+			}
+		}
+
+		SDL_UnlockMutex(mutex_);
+	}
+
+}
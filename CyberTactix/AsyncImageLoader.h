@@ -0,0 +1,94 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <SDL_thread.h>
+#include <SDL_mutex.h>
+#include <SDL_surface.h>
+#include "Uncopyable.h"
+#include "ImageTexture.h"
+
+namespace pix
+{
+	// AsyncImageLoader decodes images on a pool of worker threads and uploads them into ImageTexture objects on the main thread.
+	//
+	// Technical note:
+	// Decoding an image file into an SDL_Surface (IMG_Load) does not touch the renderer and is safe off the render thread.
+	// Creating an SDL_Texture is not, so the upload step is deferred to ProcessUploads(), which must be called on the render thread.
+	// ProcessUploads() runs under a time budget so that a burst of finished decodes does not stall a single frame.
+	// A target texture keeps its previous state until its upload completes; it becomes valid (IsInitialized()) at that point.
+	// The blend state of the target texture is preserved across the upload, as with ImageTexture::Reload().
+	//
+	// Usage:
+	// 1) Call Load() for every image that should be streamed in, e.g. at the start of a level transition.
+	// 2) Call ProcessUploads() once per frame on the main thread, e.g. at the beginning of Render().
+	// 3) Query IsPending() or IsIdle() to find out when the requested textures are ready.
+	//
+	// Philosophy:
+	// AsyncImageLoader does not own the target textures. A target texture must outlive its request,
+	// or the request must be cancelled before the texture is destroyed.
+	// Decode failures are collected on the workers and logged on the main thread during ProcessUploads().
+	class AsyncImageLoader : private Uncopyable
+	{
+	public:
+
+		// Starts workerCount decoder threads (clamped to [1, 16])
+		explicit AsyncImageLoader(int workerCount = 2);
+
+		// Stops the worker threads and discards all unfinished requests. Target textures are left unchanged.
+		~AsyncImageLoader();
+
+		// Queues imagePath for decoding into texture.
+		// Returns a request ID greater than zero, or 0 if the request could not be queued.
+		int Load(ImageTexture& texture, const std::string& imagePath);
+
+		// Cancels the request with the given ID. Its target texture is left unchanged.
+		// Returns true if the request was still pending, false otherwise.
+		bool Cancel(int requestID);
+
+		// Cancels all pending requests
+		void CancelAll();
+
+		// Uploads decoded images into their target textures. Must be called on the render thread.
+		// Uploads stop once timeBudget (in milliseconds) is used up; at least one upload is performed if one is ready.
+		// Returns the number of requests completed in this call, including failed ones.
+		int ProcessUploads(double timeBudget = 2.0);
+
+		// Returns true if the request with the given ID has neither completed nor been cancelled
+		bool IsPending(int requestID) const;
+
+		// Returns the number of requests that have neither completed nor been cancelled
+		int GetPendingCount() const;
+
+		// Returns true if no request is pending
+		bool IsIdle() const;
+
+		int GetWorkerCount() const;
+
+	private:
+
+		struct Request
+		{
+			int ID = 0;
+			ImageTexture* Texture = nullptr;
+			std::string ImagePath;
+			SDL_Surface* Surface = nullptr; // Decoded image, owned by the request until uploaded
+			std::string ErrorMessage; // Set by the worker if decoding failed
+		};
+
+		static int SDLCALL RunWorker(void* loader);
+
+		void RunDecodeLoop();
+
+		std::vector<SDL_Thread*> workers_;
+		std::deque<Request> decodeQueue_;  // Waiting to be decoded
+		std::deque<Request> uploadQueue_;  // Decoded (or failed), waiting to be uploaded on the main thread
+		std::vector<int> decodingIDs_;     // Currently being decoded by a worker
+		std::vector<int> cancelledIDs_;    // Cancelled while being decoded
+		SDL_mutex* mutex_ = nullptr;
+		SDL_cond* decodeCondition_ = nullptr;
+		int nextRequestID_ = 1;
+		bool isStopping_ = false;
+	};
+}
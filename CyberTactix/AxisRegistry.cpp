@@ -0,0 +1,91 @@
+#include "AxisRegistry.h"
+#include "ErrorLogger.h"
+
+namespace pix
+{
+
+	AxisRegistry& AxisRegistry::Get()
+	{
+		static AxisRegistry axisRegistry_;
+		return axisRegistry_;
+	}
+
+	AxisHandle AxisRegistry::Intern(const std::string& axisName)
+	{
+		AxisHandle axis;
+
+		if (axisName.empty()) return axis;
+
+		SDL_LockMutex(mutex_);
+
+		auto it = axisIDs_.find(axisName);
+
+		if (it != axisIDs_.end())
+		{
+			axis.ID = it->second;
+		}
+		else
+		{
+			axis.ID = axisNames_.size();
+			axisIDs_.emplace(axisName, axis.ID);
+			axisNames_.push_back(axisName);
+		}
+
+		SDL_UnlockMutex(mutex_);
+
+		return axis;
+	}
+
+	AxisHandle AxisRegistry::Find(const std::string& axisName) const
+	{
+		AxisHandle axis;
+
+		SDL_LockMutex(mutex_);
+
+		auto it = axisIDs_.find(axisName);
+		if (it != axisIDs_.end()) axis.ID = it->second;
+
+		SDL_UnlockMutex(mutex_);
+
+		return axis;
+	}
+
+	std::string AxisRegistry::GetName(AxisHandle axis) const
+	{
+		std::string axisName;
+
+		SDL_LockMutex(mutex_);
+
+		if (axis.ID >= 0 && axis.ID < (int)axisNames_.size())
+			axisName = axisNames_[axis.ID];
+
+		SDL_UnlockMutex(mutex_);
+
+		return axisName;
+	}
+
+	int AxisRegistry::GetAxisCount() const
+	{
+		SDL_LockMutex(mutex_);
+		const int axisCount = axisNames_.size();
+		SDL_UnlockMutex(mutex_);
+
+		return axisCount;
+	}
+
+
+
+	AxisRegistry::AxisRegistry()
+	{
+		mutex_ = SDL_CreateMutex();
+
+		if (!mutex_)
+			ErrorLogger::Get().LogSDLError("AxisRegistry::AxisRegistry() - SDL_CreateMutex() failure");
+	}
+
+	AxisRegistry::~AxisRegistry()
+	{
+		SDL_DestroyMutex(mutex_);
+	}
+
+}
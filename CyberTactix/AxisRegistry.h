@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <SDL_mutex.h>
+#include "Uncopyable.h"
+
+namespace pix
+{
+	// Interned axis name. The ID is the same for the same name in every ObjectInput, so a handle can be shared by all of them.
+	// ID -1 is the invalid handle.
+	struct AxisHandle
+	{
+		int ID = -1;
+	};
+
+	// The AxisRegistry singleton interns axis names into AxisHandle IDs, which are assigned consecutively from 0.
+	//
+	// Technical note:
+	// Interning hashes the name once; ObjectInput then resolves a handle with two array lookups instead of comparing names.
+	// Interning and name lookups are guarded by a mutex and may be called from any thread. Handles stay valid for the lifetime of the program.
+	//
+	// Usage:
+	// static const AxisHandle JUMP_AXIS = AxisRegistry::Get().Intern("Jump"); // Once, at registration time
+	// if (objectInput.BecamePositive(JUMP_AXIS)) ...                           // Hot path, no string handling
+	class AxisRegistry : private Uncopyable
+	{
+	public:
+
+		// Returns the AxisRegistry instance
+		static AxisRegistry& Get();
+
+		// Returns the handle for axisName, registering it if needed. Returns the invalid handle for an empty name.
+		AxisHandle Intern(const std::string& axisName);
+
+		// Returns the handle for axisName, or the invalid handle if axisName is not registered
+		AxisHandle Find(const std::string& axisName) const;
+
+		// Returns an empty string for the invalid handle
+		std::string GetName(AxisHandle axis) const;
+
+		// Returns the number of registered names; all valid IDs are smaller
+		int GetAxisCount() const;
+
+	private:
+
+		AxisRegistry();
+		~AxisRegistry();
+
+		SDL_mutex* mutex_ = nullptr;
+		std::unordered_map<std::string, int> axisIDs_;
+		std::vector<std::string> axisNames_; // Indexed by ID
+	};
+
+}
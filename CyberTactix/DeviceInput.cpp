@@ -0,0 +1,236 @@
+#include "DeviceInput.h"
+#include <algorithm>
+#include <SDL_keyboard.h>
+#include "PixMath.h"
+
+namespace pix
+{
+
+	bool DeviceState::IsKeyDown(SDL_Scancode key) const
+	{
+		if (key < 0 || key >= SDL_NUM_SCANCODES) return false;
+
+		return KeyStates[key] != 0;
+	}
+
+	bool DeviceState::IsMouseButtonDown(MouseInput::Button button) const
+	{
+		return (MouseButtonFlags & SDL_BUTTON(button)) != 0;
+	}
+
+	bool DeviceState::IsGamepadButtonDown(int gamepadIndex, SDL_GameControllerButton button) const
+	{
+		if (gamepadIndex < 0 || gamepadIndex >= MAX_GAMEPAD_COUNT || button < 0 || button >= SDL_CONTROLLER_BUTTON_MAX) return false;
+
+		return (Gamepads[gamepadIndex].ButtonFlags & (1u << button)) != 0;
+	}
+
+	float DeviceState::GetGamepadAxisValue(int gamepadIndex, SDL_GameControllerAxis axis) const
+	{
+		if (gamepadIndex < 0 || gamepadIndex >= MAX_GAMEPAD_COUNT || axis < 0 || axis >= SDL_CONTROLLER_AXIS_MAX) return 0.0f;
+
+		return Gamepads[gamepadIndex].Axes[axis];
+	}
+
+
+
+	DeviceInput& DeviceInput::Get()
+	{
+		static DeviceInput deviceInput_;
+		return deviceInput_;
+	}
+
+	void DeviceInput::Update()
+	{
+		if (isEventCapture_)
+		{
+			TakeQueuedEvents();
+
+			events_.swap(pendingEvents_);
+			pendingEvents_.clear();
+		}
+
+		int keyCount = 0;
+		const Uint8* keyStates = SDL_GetKeyboardState(&keyCount);
+
+		if (keyStates)
+		{
+			if (keyCount > SDL_NUM_SCANCODES) keyCount = SDL_NUM_SCANCODES;
+
+			SDL_memcpy(state_.KeyStates, keyStates, keyCount);
+		}
+
+		const MouseInput& mouseInput = MouseInput::Get();
+
+		state_.MouseButtonFlags = 0;
+
+		for (int button = MouseInput::LEFT; button < MouseInput::BUTTON_MAX; button++)
+		{
+			if (mouseInput.IsButtonDown((MouseInput::Button)button))
+				state_.MouseButtonFlags |= SDL_BUTTON(button);
+		}
+
+		state_.MousePositionX = mouseInput.GetMousePositionX();
+		state_.MousePositionY = mouseInput.GetMousePositionY();
+
+		const GamepadInput& gamepadInput = GamepadInput::Get();
+
+		int gamepadSlotCount = gamepadInput.GetGamepadSlotCount();
+		if (gamepadSlotCount > DeviceState::MAX_GAMEPAD_COUNT) gamepadSlotCount = DeviceState::MAX_GAMEPAD_COUNT;
+
+		for (int i = 0; i < DeviceState::MAX_GAMEPAD_COUNT; i++)
+		{
+			DeviceState::GamepadState& gamepadState = state_.Gamepads[i];
+
+			gamepadState.IsConnected = i < gamepadSlotCount && gamepadInput.IsValidGamepadIndex(i);
+			gamepadState.ButtonFlags = 0;
+
+			if (!gamepadState.IsConnected)
+			{
+				for (int axis = 0; axis < SDL_CONTROLLER_AXIS_MAX; axis++)
+					gamepadState.Axes[axis] = 0.0f;
+
+				continue;
+			}
+
+			for (int button = 0; button < SDL_CONTROLLER_BUTTON_MAX; button++)
+			{
+				if (gamepadInput.IsButtonDown(i, (SDL_GameControllerButton)button))
+					gamepadState.ButtonFlags |= 1u << button;
+			}
+
+			for (int axis = 0; axis < SDL_CONTROLLER_AXIS_MAX; axis++)
+				gamepadState.Axes[axis] = gamepadInput.GetAxisValue(i, (SDL_GameControllerAxis)axis);
+		}
+	}
+
+	void DeviceInput::SetState(const DeviceState& state)
+	{
+		state_ = state;
+		events_.clear();
+	}
+
+	const DeviceState& DeviceInput::GetState() const
+	{
+		return state_;
+	}
+
+	void DeviceInput::HandleEvent(const SDL_Event& event)
+	{
+		if (!isEventCapture_) return;
+
+		InputEvent inputEvent;
+		inputEvent.Timestamp = event.common.timestamp;
+
+		switch (event.type)
+		{
+		case SDL_KEYDOWN:
+		case SDL_KEYUP:
+			if (event.key.repeat != 0) return;
+
+			inputEvent.Source = InputEvent::KEY;
+			inputEvent.Code = event.key.keysym.scancode;
+			inputEvent.Value = event.type == SDL_KEYDOWN ? 1.0f : 0.0f;
+			break;
+
+		case SDL_MOUSEBUTTONDOWN:
+		case SDL_MOUSEBUTTONUP:
+			inputEvent.Source = InputEvent::MOUSE_BUTTON;
+			inputEvent.Code = event.button.button;
+			inputEvent.Value = event.type == SDL_MOUSEBUTTONDOWN ? 1.0f : 0.0f;
+			break;
+
+		case SDL_CONTROLLERBUTTONDOWN:
+		case SDL_CONTROLLERBUTTONUP:
+			inputEvent.Source = InputEvent::GAMEPAD_BUTTON;
+			inputEvent.Code = event.cbutton.button;
+			inputEvent.GamepadIndex = GamepadInput::Get().GetGamepadIndex(event.cbutton.which);
+			inputEvent.Value = event.type == SDL_CONTROLLERBUTTONDOWN ? 1.0f : 0.0f;
+			break;
+
+		case SDL_CONTROLLERAXISMOTION:
+			inputEvent.Source = InputEvent::GAMEPAD_AXIS;
+			inputEvent.Code = event.caxis.axis;
+			inputEvent.GamepadIndex = GamepadInput::Get().GetGamepadIndex(event.caxis.which);
+			inputEvent.Value = GetClamped(event.caxis.value / float(SDL_JOYSTICK_AXIS_MAX), -1.0f, 1.0f); // As GamepadInput::GetAxisValue()
+			break;
+
+		default:
+			return;
+		}
+
+		if (pendingEvents_.size() >= MAX_EVENT_COUNT)
+		{
+			droppedEventCount_++;
+			return;
+		}
+
+		pendingEvents_.push_back(inputEvent);
+	}
+
+	void DeviceInput::SetEventCapture(bool isEnabled)
+	{
+		isEventCapture_ = isEnabled;
+
+		events_.clear();
+		pendingEvents_.clear();
+		droppedEventCount_ = 0;
+	}
+
+	const std::vector<InputEvent>& DeviceInput::GetEvents() const
+	{
+		return events_;
+	}
+
+	void DeviceInput::ClearEvents()
+	{
+		events_.clear();
+	}
+
+	int DeviceInput::GetDroppedEventCount() const
+	{
+		return droppedEventCount_;
+	}
+
+	bool DeviceInput::IsEventCapture() const
+	{
+		return isEventCapture_;
+	}
+
+
+
+	void DeviceInput::TakeQueuedEvents()
+	{
+		// Only input event types are taken, so other events stay queued for GameLoop's event poll
+		const Uint32 eventTypeRanges[][2] =
+		{
+			{ SDL_KEYDOWN, SDL_KEYUP },
+			{ SDL_MOUSEBUTTONDOWN, SDL_MOUSEBUTTONUP },
+			{ SDL_CONTROLLERAXISMOTION, SDL_CONTROLLERBUTTONUP }
+		};
+
+		constexpr int BATCH_SIZE = 32;
+		SDL_Event events[BATCH_SIZE];
+
+		const int firstIndex = pendingEvents_.size();
+
+		for (const auto& eventTypeRange : eventTypeRanges)
+		{
+			int eventCount = 0;
+
+			do
+			{
+				eventCount = SDL_PeepEvents(events, BATCH_SIZE, SDL_GETEVENT, eventTypeRange[0], eventTypeRange[1]);
+
+				for (int i = 0; i < eventCount; i++)
+					HandleEvent(events[i]);
+
+			} while (eventCount == BATCH_SIZE);
+		}
+
+		// Merge the event type ranges back into the order SDL received the events
+		std::stable_sort(pendingEvents_.begin() + firstIndex, pendingEvents_.end(),
+			[](const InputEvent& a, const InputEvent& b) { return a.Timestamp < b.Timestamp; });
+	}
+
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <vector>
+#include <SDL_scancode.h>
+#include <SDL_gamecontroller.h>
+#include <SDL_events.h>
+#include "Uncopyable.h"
+#include "Input.h"
+
+namespace pix
+{
+	// Immutable snapshot of keyboard, mouse, and gamepad state at one point in time.
+	// A plain value type: it can be copied, e.g. to hand the input of an update to a simulation thread.
+	struct DeviceState
+	{
+		static constexpr int MAX_GAMEPAD_COUNT = 32; // Gamepad slots beyond this index read as disconnected
+
+		struct GamepadState
+		{
+			float Axes[SDL_CONTROLLER_AXIS_MAX] = {}; // Normalized as by GamepadInput::GetAxisValue()
+			Uint32 ButtonFlags = 0;                   // Bit i is set if button i is pressed
+			bool IsConnected = false;
+		};
+
+		// Returns true if the key is pressed, false otherwise
+		bool IsKeyDown(SDL_Scancode key) const;
+
+		// Returns true if the button is pressed, false otherwise
+		bool IsMouseButtonDown(MouseInput::Button button) const;
+
+		// Returns false for disconnected or invalid gamepad slots
+		bool IsGamepadButtonDown(int gamepadIndex, SDL_GameControllerButton button) const;
+
+		// Returns 0.0f for disconnected or invalid gamepad slots
+		float GetGamepadAxisValue(int gamepadIndex, SDL_GameControllerAxis axis) const;
+
+		Uint8 KeyStates[SDL_NUM_SCANCODES] = {};
+		GamepadState Gamepads[MAX_GAMEPAD_COUNT];
+		Uint32 MouseButtonFlags = 0;
+		int MousePositionX = 0;
+		int MousePositionY = 0;
+	};
+
+
+	// A key, button, or gamepad axis transition with the time SDL received it, captured by DeviceInput
+	struct InputEvent
+	{
+		enum SourceType
+		{
+			KEY,
+			MOUSE_BUTTON,
+			GAMEPAD_BUTTON,
+			GAMEPAD_AXIS
+		};
+
+		Uint32 Timestamp = 0;        // SDL event timestamp in milliseconds, on the clock of SDL_GetTicks()
+		SourceType Source = KEY;
+		int Code = 0;                // SDL_Scancode, MouseInput::Button, SDL_GameControllerButton, or SDL_GameControllerAxis
+		int GamepadIndex = -1;       // Gamepad sources only
+		float Value = 0.0f;          // 1.0f for press, 0.0f for release, normalized value for gamepad axes
+	};
+
+
+	// The DeviceInput singleton captures the state of all input devices into a DeviceState once per update.
+	//
+	// Technical note:
+	// Input pumps read the captured DeviceState instead of querying the Input singletons, so the cost of reading device state
+	// is paid once per update (one SDL query per gamepad button and axis) instead of once per binding of every ObjectInput.
+	// The snapshot is a contiguous struct of about 1.5 KB that stays cache-resident while many ObjectInputs are pumped.
+	// GameLoop calls Update() right after SDL state was refreshed by event polling or SDL_PumpEvents().
+	//
+	// Event capture:
+	// Polled state tells what is pressed, but not when it changed within the frame. With event capture on, the key, button,
+	// and gamepad axis events received since the previous Update() are kept with their SDL timestamps as the events of the update.
+	// Events still queued after SDL_PumpEvents() are taken from the SDL queue by Update(), so each update sees the events that led
+	// to its state. Key repeat events are skipped, as they are no transitions.
+	// Events received in a frame without update are replaced by the next Update() and seen by no update.
+	// In pipelined mode, Update() runs once per frame; GameLoop clears the events after the first update of the frame,
+	// so that each event is seen by exactly one update there as well.
+	// Event capture is off by default, as gamepad axis motion can produce many events per frame; see LaunchConfigData::IsInputEventCapture.
+	//
+	// Philosophy:
+	// The Input singletons stay the live, low-level source. DeviceInput is the consistent per-update view for higher-level input.
+	// SetState() replaces the snapshot, e.g. to feed recorded input or a snapshot captured on another thread.
+	class DeviceInput : private Uncopyable
+	{
+	public:
+
+		// Returns the DeviceInput instance
+		static DeviceInput& Get();
+
+		// Captures the current state of KeyboardInput, MouseInput, and GamepadInput.
+		// Call MouseInput::Update() first, so the mouse state is current.
+		void Update();
+
+		// Replaces the captured state until the next Update(). The events of the update are cleared, as they belong to the replaced state.
+		void SetState(const DeviceState& state);
+
+		const DeviceState& GetState() const;
+
+		// Queues a key, mouse button, or gamepad event for the next Update() if event capture is on. Other events are ignored.
+		// Called by GameLoop for the events it polls.
+		void HandleEvent(const SDL_Event& event);
+
+		// Turns event capture on or off. Turning it off clears all captured events.
+		void SetEventCapture(bool isEnabled);
+
+		// Returns the events received between the previous and the last Update(), in the order SDL received them
+		const std::vector<InputEvent>& GetEvents() const;
+
+		// Clears the events of the last Update(), so that further updates on the same captured state do not see them again
+		void ClearEvents();
+
+		// Returns the number of events dropped since event capture was turned on, because an update exceeded MAX_EVENT_COUNT
+		int GetDroppedEventCount() const;
+
+		bool IsEventCapture() const;
+
+		static constexpr int MAX_EVENT_COUNT = 1024; // Events per update
+
+	private:
+
+		DeviceInput() = default;
+		~DeviceInput() = default;
+
+		// Moves the key, button, and gamepad events still in the SDL queue to pendingEvents_
+		void TakeQueuedEvents();
+
+		DeviceState state_;
+		std::vector<InputEvent> events_;        // Events of the last Update()
+		std::vector<InputEvent> pendingEvents_; // Events for the next Update()
+		int droppedEventCount_ = 0;
+		bool isEventCapture_ = false;
+	};
+
+}
@@ -1,9 +1,47 @@
 
 #include "ErrorLogger.h"
+#include <cstdlib>
+#include <exception>
 #include <SDL.h>
 
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
 namespace pix
 {
+
+	namespace
+	{
+		constexpr Uint32 CRASH_FLUSH_TIMEOUT = 200; // Milliseconds FlushOnCrash() waits for the writer thread to finish its batch
+
+		std::terminate_handler prevTerminateHandler = nullptr;                   // Of the thread that called Init()
+		thread_local std::terminate_handler prevThreadTerminateHandler = nullptr; // Of other threads, where the CRT keeps handlers per thread
+
+		void HandleTerminate()
+		{
+			ErrorLogger::Get().FlushOnCrash();
+
+			const std::terminate_handler prevHandler = prevThreadTerminateHandler ? prevThreadTerminateHandler : prevTerminateHandler;
+
+			if (prevHandler) prevHandler();
+
+			std::abort();
+		}
+
+#ifdef _WIN32
+		LPTOP_LEVEL_EXCEPTION_FILTER prevExceptionFilter = nullptr;
+
+		LONG WINAPI HandleUnhandledException(EXCEPTION_POINTERS* exceptionInfo)
+		{
+			ErrorLogger::Get().FlushOnCrash();
+
+			return prevExceptionFilter ? prevExceptionFilter(exceptionInfo) : EXCEPTION_CONTINUE_SEARCH;
+		}
+#endif
+	}
+
 	ErrorLogger& ErrorLogger::Get() 
 	{
 		static ErrorLogger errorLogger_;
@@ -15,7 +53,7 @@ namespace pix
 
 	bool ErrorLogger::Init(const std::string& outputDirectory, int maxCountPerError)
 	{
-		if (isInitialized_) return true;
+		if (IsInitialized()) return true;
 
 		if (outputDirectory.empty()) return false;
 
@@ -28,8 +66,6 @@ namespace pix
 		SDL_RWops* file = SDL_RWFromFile(outputPath.c_str(), "w"); // Opens in "w" mode to truncate or create
 		if (!file) return false;
 
-		SDL_RWclose(file);
-
 		outputPath_ = outputPath;
 
 		maxCountPerError_ = maxCountPerError;
@@ -38,85 +74,257 @@ namespace pix
 		else if (maxCountPerError_ > MAX_LOG_ENTRIES)
 			maxCountPerError_ = MAX_LOG_ENTRIES;
 
+		// The writer thread takes over the open file. SDL threads and mutexes do not require SDL_Init().
+		file_ = file;
+		writerSemaphore_ = SDL_CreateSemaphore(0);
+		flushMutex_ = SDL_CreateMutex();
+		flushCondition_ = SDL_CreateCond();
+
+		if (writerSemaphore_ && flushMutex_ && flushCondition_)
+		{
+			SDL_AtomicSet(&isWriterStopping_, 0);
+			writerThread_ = SDL_CreateThread(RunWriter, "PixErrorLogger", this);
+		}
+
+		if (writerThread_)
+			InstallCrashHandlers();
+
+		SDL_LockMutex(stateMutex_);
 		isInitialized_ = true;
+		SDL_UnlockMutex(stateMutex_);
+
+		if (!writerThread_)
+		{
+			Destroy(); // Falls back to synchronous writes
+			LogSDLError("ErrorLogger::Init() - SDL_CreateThread() failure");
+		}
 
 		return true;
 	}
 
-	void ErrorLogger::LogSDLError(const std::string& errorName)
+	void ErrorLogger::Destroy()
 	{
-		if (!isLoggingEnabled_ || !isInitialized_ || errors_.size() >= MAX_LOG_ENTRIES) return;
+		UninstallCrashHandlers();
 
-		const char* sdlError = SDL_GetError();
-		if (!sdlError || (*sdlError) == '\0')
-			return;
+		if (writerThread_)
+		{
+			SDL_AtomicSet(&isWriterStopping_, 1);
+			SDL_SemPost(writerSemaphore_);
+			SDL_WaitThread(writerThread_, nullptr);
+			writerThread_ = nullptr;
+		}
 
-		std::string errorMessage = sdlError;
-		SDL_ClearError();
+		// Requests pushed while the writer thread was stopping
+		SDL_AtomicLock(&consumerLock_);
+		ProcessWriteRequests();
+		SDL_AtomicUnlock(&consumerLock_);
+
+		if (file_)
+		{
+			SDL_RWclose(file_);
+			file_ = nullptr;
+		}
+
+		SDL_DestroyCond(flushCondition_);
+		SDL_DestroyMutex(flushMutex_);
+		SDL_DestroySemaphore(writerSemaphore_);
+		flushCondition_ = nullptr;
+		flushMutex_ = nullptr;
+		writerSemaphore_ = nullptr;
+	}
+
+	void ErrorLogger::Flush()
+	{
+		if (!writerThread_) return; // Errors are written synchronously
 
-		int& count = errorCounts_[errorName];
-		if (count >= maxCountPerError_) return;
+		// Requests are counted before they are pushed, so the target covers every request pushed before this point
+		const int targetCount = SDL_AtomicGet(&queuedCount_);
 
-		WriteToFile(FormatError(errorName, errorMessage));
-		errors_.emplace_back(errorName, errorMessage);
-		++count;
+		SDL_LockMutex(flushMutex_);
+
+		while (SDL_AtomicGet(&writtenCount_) < targetCount)
+			SDL_CondWait(flushCondition_, flushMutex_);
+
+		SDL_UnlockMutex(flushMutex_);
+	}
+
+	void ErrorLogger::FlushOnCrash()
+	{
+		if (!writerThread_) return; // Errors are written synchronously
+
+		// Neither allocates nor blocks, as the crash may have happened inside the allocator or while a lock was held.
+		// Spins for a batch in progress; a writer thread that crashed itself never releases the lock.
+		const Uint32 startTicks = SDL_GetTicks();
+
+		while (!SDL_AtomicTryLock(&consumerLock_))
+		{
+			if (SDL_GetTicks() - startTicks >= CRASH_FLUSH_TIMEOUT) return;
+		}
+
+		if (!file_) return;
+
+		// Writes the queued texts in place, without popping: popping frees nodes. Pending truncations are ignored.
+		// The lock is kept, so that the writer thread does not write the errors a second time.
+		WriteRequest* writeRequest = (WriteRequest*)SDL_AtomicGetPtr((void**)&queueTail_->Next);
+
+		while (writeRequest)
+		{
+			if (!writeRequest->IsTruncate && !writeRequest->Text.empty())
+				SDL_RWwrite(file_, writeRequest->Text.data(), 1, writeRequest->Text.size());
+
+			writeRequest = (WriteRequest*)SDL_AtomicGetPtr((void**)&writeRequest->Next);
+		}
+	}
+
+	void ErrorLogger::InstallThreadCrashHandler()
+	{
+		if (!isCrashHandlerInstalled_) return;
+
+		// Where the handler is global, this returns HandleTerminate itself, which must not be chained
+		const std::terminate_handler prevHandler = std::set_terminate(HandleTerminate);
+
+		if (prevHandler != HandleTerminate)
+			prevThreadTerminateHandler = prevHandler;
+	}
+
+	ErrorHandle ErrorLogger::RegisterError(const std::string& errorName)
+	{
+		ErrorHandle error;
+
+		SDL_LockMutex(stateMutex_);
+
+		auto it = errorIDs_.find(errorName);
+
+		if (it != errorIDs_.end())
+		{
+			error.ID = it->second;
+		}
+		else if (errorNames_.size() < MAX_ERROR_NAMES)
+		{
+			error.ID = errorNames_.size();
+			errorNames_.push_back(errorName);
+			errorIDs_[errorName] = error.ID;
+		}
+
+		SDL_UnlockMutex(stateMutex_);
+
+		if (error.ID < 0)
+			AddError(OVERFLOW_ERROR_ID, "Too many distinct error names, further names are not logged!");
+
+		return error;
+	}
+
+	void ErrorLogger::LogSDLError(const std::string& errorName)
+	{
+		LogSDLError(RegisterError(errorName));
 	}
 
 	void ErrorLogger::LogError(const std::string& errorName, const std::string& errorMessage)
 	{
-		if (!isLoggingEnabled_ || !isInitialized_ || errors_.size() >= MAX_LOG_ENTRIES) return;
+		AddError(RegisterError(errorName).ID, errorMessage.c_str());
+	}
 
-		int& count = errorCounts_[errorName]; // Inserts value 0 if there is none
-		if (count >= maxCountPerError_) return;
+	void ErrorLogger::LogSDLError(ErrorHandle error)
+	{
+		if (IsErrorLoggable(error))
+		{
+			const char* sdlError = SDL_GetError(); // The SDL error is per thread
+			if (!sdlError || (*sdlError) == '\0')
+				return;
+
+			AddError(error.ID, sdlError); // Copies the message before it is cleared
+		}
 
-		WriteToFile(FormatError(errorName, errorMessage));
-		errors_.emplace_back(errorName, errorMessage);
-		++count;
+		SDL_ClearError();
+	}
+
+	void ErrorLogger::LogError(ErrorHandle error, const char* errorMessage)
+	{
+		AddError(error.ID, errorMessage);
+	}
+
+	void ErrorLogger::LogError(ErrorHandle error, const std::string& errorMessage)
+	{
+		AddError(error.ID, errorMessage.c_str());
+	}
+
+	bool ErrorLogger::IsErrorLoggable(ErrorHandle error) const
+	{
+		return error.ID >= 0 && error.ID < MAX_ERROR_NAMES && SDL_AtomicGet(&errorCounts_[error.ID]) < maxCountPerError_;
 	}
 
 	void ErrorLogger::ClearLog()
 	{
-		if (!isInitialized_) return;
+		SDL_LockMutex(stateMutex_);
 
-		SDL_RWops* file = SDL_RWFromFile(outputPath_.c_str(), "w");
-		if (file)
-			SDL_RWclose(file);
+		if (!isInitialized_)
+		{
+			SDL_UnlockMutex(stateMutex_);
+			return;
+		}
 
 		errors_.clear();
-		errorCounts_.clear();
+
+		// Registered names stay, so that handles remain valid
+		const int errorNameCount = errorNames_.size();
+
+		for (int i = 0; i < errorNameCount; i++)
+			SDL_AtomicSet(&errorCounts_[i], 0);
+
+		SDL_UnlockMutex(stateMutex_);
+
+		Write(std::string(), true);
 	}
 
 
 
 	void ErrorLogger::SetLoggingEnabled(bool value)
 	{
+		SDL_LockMutex(stateMutex_);
 		isLoggingEnabled_ = value;
+		SDL_UnlockMutex(stateMutex_);
 	}
 
 
-	std::string ErrorLogger::GetErrorByIndex(int index) const 
+	std::string ErrorLogger::GetErrorByIndex(int index) const
 	{
-		if (errors_.empty()) return std::string();
+		std::string foundError;
+
+		SDL_LockMutex(stateMutex_);
+
+		if (!errors_.empty())
+		{
+			if (index < 0) index = 0;
+			else if (index >= (int)errors_.size())
+			  index = errors_.size() - 1;
+
+			foundError = FormatError(errorNames_[errors_[index].ErrorID], errors_[index].Message);
+		}
 
-		if (index < 0) index = 0;
-		else if (index >= errors_.size())
-		  index = errors_.size() - 1;
+		SDL_UnlockMutex(stateMutex_);
 
-		return FormatError(errors_[index].Name, errors_[index].Message);
+		return foundError;
 	}
 
 	std::string ErrorLogger::GetErrorByName(const std::string& errorName) const
 	{
 		std::string foundErrors;
 
-		const int errorCount = errors_.size();
+		SDL_LockMutex(stateMutex_);
+
+		auto it = errorIDs_.find(errorName);
+
+		const int errorID = it != errorIDs_.end() ? it->second : -1;
+		const int errorCount = errorID >= 0 ? errors_.size() : 0;
 
 		for (int i = 0; i < errorCount; i++)
 		{
-			if (errors_[i].Name == errorName)
-				foundErrors += FormatError(errors_[i].Name, errors_[i].Message);
+			if (errors_[i].ErrorID == errorID)
+				foundErrors += FormatError(errorName, errors_[i].Message);
 		}
 
+		SDL_UnlockMutex(stateMutex_);
+
 		return foundErrors;
 	}
 
@@ -124,31 +332,66 @@ namespace pix
 	{
 		std::string allErrors;
 
+		SDL_LockMutex(stateMutex_);
+
 		const int errorCount = errors_.size();
 
 		for (int i = 0; i < errorCount; i++)
-			allErrors += FormatError(errors_[i].Name, errors_[i].Message);
+			allErrors += FormatError(errorNames_[errors_[i].ErrorID], errors_[i].Message);
+
+		SDL_UnlockMutex(stateMutex_);
 
 		return allErrors;
 	}
 
 	int ErrorLogger::GetTotalErrorCount() const
 	{
-		return errors_.size();
+		SDL_LockMutex(stateMutex_);
+		const int errorCount = errors_.size();
+		SDL_UnlockMutex(stateMutex_);
+
+		return errorCount;
 	}
 
 	int ErrorLogger::GetTotalUniqueErrorCount() const
 	{
-		return errorCounts_.size();
+		int uniqueErrorCount = 0;
+
+		SDL_LockMutex(stateMutex_);
+
+		const int errorNameCount = errorNames_.size();
+
+		for (int i = 0; i < errorNameCount; i++)
+		{
+			if (SDL_AtomicGet(&errorCounts_[i]) > 0)
+				uniqueErrorCount++;
+		}
+
+		SDL_UnlockMutex(stateMutex_);
+
+		return uniqueErrorCount;
 	}
 
 	int ErrorLogger::GetErrorCount(const std::string& errorName) const
 	{
-		auto it = errorCounts_.find(errorName);
+		int errorCount = 0;
 
-		if (it != errorCounts_.end()) return it->second;
+		SDL_LockMutex(stateMutex_);
 
-		return 0;
+		auto it = errorIDs_.find(errorName);
+
+		if (it != errorIDs_.end()) errorCount = SDL_AtomicGet(&errorCounts_[it->second]);
+
+		SDL_UnlockMutex(stateMutex_);
+
+		return errorCount;
+	}
+
+	int ErrorLogger::GetErrorCount(ErrorHandle error) const
+	{
+		if (error.ID < 0 || error.ID >= MAX_ERROR_NAMES) return 0;
+
+		return SDL_AtomicGet(&errorCounts_[error.ID]);
 	}
 
 	const std::string& ErrorLogger::GetOutputPath() const
@@ -163,21 +406,217 @@ namespace pix
 
 	bool ErrorLogger::IsLoggingEnabled() const
 	{
-		return isLoggingEnabled_;
+		SDL_LockMutex(stateMutex_);
+		const bool isLoggingEnabled = isLoggingEnabled_;
+		SDL_UnlockMutex(stateMutex_);
+
+		return isLoggingEnabled;
 	}
 
 	bool ErrorLogger::IsInitialized() const
 	{
-		return isInitialized_;
+		SDL_LockMutex(stateMutex_);
+		const bool isInitialized = isInitialized_;
+		SDL_UnlockMutex(stateMutex_);
+
+		return isInitialized;
 	}
 
 
-	ErrorLogger::Error::Error(const std::string& name, const std::string& message) :
-		Name(name),
+	ErrorLogger::Error::Error(int errorID, const std::string& message) :
+		ErrorID(errorID),
 		Message(message)
 	{
 	}
 
+	ErrorLogger::ErrorLogger()
+	{
+		stateMutex_ = SDL_CreateMutex();
+
+		for (int i = 0; i < MAX_ERROR_NAMES; i++)
+			SDL_AtomicSet(&errorCounts_[i], 0);
+
+		RegisterError("ErrorLogger::RegisterError() failure"); // OVERFLOW_ERROR_ID
+
+		SDL_AtomicSet(&queuedCount_, 0);
+		SDL_AtomicSet(&writtenCount_, 0);
+		SDL_AtomicSet(&isWriterStopping_, 0);
+
+		queueHead_ = queueTail_ = new WriteRequest(); // Stub
+	}
+
+	ErrorLogger::~ErrorLogger()
+	{
+		Destroy();
+
+		delete queueTail_; // Only the stub is left after Destroy()
+
+		SDL_DestroyMutex(stateMutex_);
+	}
+
+	int SDLCALL ErrorLogger::RunWriter(void* errorLogger)
+	{
+		ErrorLogger* self = (ErrorLogger*)errorLogger;
+
+		while (true)
+		{
+			SDL_SemWait(self->writerSemaphore_);
+
+			SDL_AtomicLock(&self->consumerLock_);
+			self->ProcessWriteRequests(); // Takes all queued requests, so most posts find the queue empty
+			SDL_AtomicUnlock(&self->consumerLock_);
+
+			if (SDL_AtomicGet(&self->isWriterStopping_)) break;
+		}
+
+		return 0;
+	}
+
+	void ErrorLogger::AddError(int errorID, const char* errorMessage)
+	{
+		// Fast path for errors over their cap: one atomic read, no lock, no allocation
+		if (errorID < 0 || errorID >= MAX_ERROR_NAMES || SDL_AtomicGet(&errorCounts_[errorID]) >= maxCountPerError_)
+			return;
+
+		SDL_LockMutex(stateMutex_);
+
+		// Counts only change under the mutex, so the check is exact here
+		if (!isLoggingEnabled_ || !isInitialized_ || errors_.size() >= MAX_LOG_ENTRIES || errorID >= (int)errorNames_.size() ||
+			SDL_AtomicGet(&errorCounts_[errorID]) >= maxCountPerError_)
+		{
+			SDL_UnlockMutex(stateMutex_);
+			return;
+		}
+
+		SDL_AtomicAdd(&errorCounts_[errorID], 1);
+		errors_.emplace_back(errorID, errorMessage ? errorMessage : "");
+
+		const std::string formattedError = FormatError(errorNames_[errorID], errors_.back().Message);
+
+		SDL_UnlockMutex(stateMutex_);
+
+		Write(formattedError, false);
+	}
+
+	void ErrorLogger::Write(const std::string& text, bool isTruncate)
+	{
+		if (!writerThread_)
+		{
+			// Synchronous fallback; the mutex serializes concurrent file access
+			SDL_LockMutex(stateMutex_);
+
+			if (isTruncate)
+			{
+				SDL_RWops* file = SDL_RWFromFile(outputPath_.c_str(), "w");
+				if (file)
+					SDL_RWclose(file);
+			}
+			else
+			{
+				WriteToFile(text);
+			}
+
+			SDL_UnlockMutex(stateMutex_);
+
+			return;
+		}
+
+		WriteRequest* writeRequest = new WriteRequest();
+		writeRequest->Text = text;
+		writeRequest->IsTruncate = isTruncate;
+
+		SDL_AtomicAdd(&queuedCount_, 1);
+		PushWriteRequest(writeRequest);
+		SDL_SemPost(writerSemaphore_);
+	}
+
+	void ErrorLogger::PushWriteRequest(WriteRequest* writeRequest)
+	{
+		// Claims the head position with one atomic exchange, then links the previous head to it.
+		// Until the link is set, the consumer sees the queue end at the previous head and retries on the next wake-up.
+		writeRequest->Next = nullptr;
+
+		WriteRequest* prevHead = (WriteRequest*)SDL_AtomicSetPtr((void**)&queueHead_, writeRequest);
+		SDL_AtomicSetPtr((void**)&prevHead->Next, writeRequest);
+	}
+
+	ErrorLogger::WriteRequest* ErrorLogger::PopWriteRequest()
+	{
+		WriteRequest* next = (WriteRequest*)SDL_AtomicGetPtr((void**)&queueTail_->Next);
+		if (!next) return nullptr;
+
+		// The popped request becomes the new stub; the caller may move its content out
+		delete queueTail_;
+		queueTail_ = next;
+
+		return next;
+	}
+
+	void ErrorLogger::ProcessWriteRequests()
+	{
+		std::string batch;
+		int processedCount = 0;
+
+		while (WriteRequest* writeRequest = PopWriteRequest())
+		{
+			if (writeRequest->IsTruncate)
+			{
+				batch.clear(); // Errors queued before the truncation are cleared as well
+
+				if (file_) SDL_RWclose(file_);
+				file_ = SDL_RWFromFile(outputPath_.c_str(), "w");
+			}
+			else
+			{
+				batch += writeRequest->Text;
+				writeRequest->Text.clear();
+			}
+
+			processedCount++;
+		}
+
+		if (!batch.empty())
+		{
+			if (file_)
+				SDL_RWwrite(file_, batch.c_str(), 1, batch.size());
+			else
+				WriteToFile(batch);
+		}
+
+		if (processedCount == 0 || !flushMutex_) return;
+
+		SDL_LockMutex(flushMutex_);
+		SDL_AtomicAdd(&writtenCount_, processedCount);
+		SDL_CondBroadcast(flushCondition_);
+		SDL_UnlockMutex(flushMutex_);
+	}
+
+	void ErrorLogger::InstallCrashHandlers()
+	{
+		if (isCrashHandlerInstalled_) return;
+
+		prevTerminateHandler = std::set_terminate(HandleTerminate);
+
+#ifdef _WIN32
+		prevExceptionFilter = SetUnhandledExceptionFilter(HandleUnhandledException);
+#endif
+
+		isCrashHandlerInstalled_ = true;
+	}
+
+	void ErrorLogger::UninstallCrashHandlers()
+	{
+		if (!isCrashHandlerInstalled_) return;
+
+		std::set_terminate(prevTerminateHandler);
+
+#ifdef _WIN32
+		SetUnhandledExceptionFilter(prevExceptionFilter);
+#endif
+
+		isCrashHandlerInstalled_ = false;
+	}
+
 	void ErrorLogger::WriteToFile(const std::string& input)
 	{
 		if (outputPath_.empty())
@@ -193,7 +632,15 @@ namespace pix
 
 	std::string ErrorLogger::FormatError(const std::string& errorName, const std::string& errorMessage) const
 	{
-		return errorName + ": " + errorMessage + "\n\n";
+		std::string formattedError;
+		formattedError.reserve(errorName.size() + errorMessage.size() + 4);
+
+		formattedError += errorName;
+		formattedError += ": ";
+		formattedError += errorMessage;
+		formattedError += "\n\n";
+
+		return formattedError;
 	}
 
-}
\ No newline at end of file
+}
@@ -1,14 +1,46 @@
 #pragma once
 
 #include <vector>
+#include <deque>
 #include <unordered_map>
 #include <string>
+#include <SDL_rwops.h>
+#include <SDL_thread.h>
+#include <SDL_mutex.h>
+#include <SDL_atomic.h>
 #include "Uncopyable.h"
 
+// Returns the ErrorHandle of errorName, which must be a string literal. The name is registered once per call site, on first use.
+// Usage: ErrorLogger::Get().LogError(PIX_ERROR_HANDLE("Texture::SetAlphaMod() failure"), "sdlTexture_ is nullptr!");
+#define PIX_ERROR_HANDLE(errorName) ([]() -> pix::ErrorHandle { static const pix::ErrorHandle errorHandle_ = pix::ErrorLogger::Get().RegisterError(errorName); return errorHandle_; }())
+
 namespace pix
 {
 
+	// Interned error name; see ErrorLogger::RegisterError(). ID -1 is the invalid handle.
+	struct ErrorHandle
+	{
+		int ID = -1;
+	};
+
 	// The ErrorLogger singleton is a lightweight global error logging facility.
+	//
+	// Technical note:
+	// Logging is thread-safe. The in-memory error state is guarded by a mutex, which is held only while the error is counted and stored.
+	// File output happens on a background writer thread: logging threads push the formatted error to a lock-free
+	// multi-producer single-consumer queue and wake the writer, which keeps the log file open and writes all queued errors in one batch.
+	// No file I/O happens on the logging thread, so errors logged every frame do not stall the game loop.
+	// Each batch is handed to the operating system right away. Flush() waits until all errors logged so far are written.
+	// The error logged right before a crash is the one most likely still queued, so Init() installs best-effort crash handlers
+	// that write the queued errors from the crashing thread without allocating or blocking: the unhandled exception filter
+	// on Windows and the std::terminate handler. MSVC's CRT keeps the terminate handler per thread, so it covers the thread that
+	// called Init() and the threads that call InstallThreadCrashHandler(), which all threads created by the library do.
+	// Fatal signals on other platforms are not handled; SDL writes files through buffered stdio there, which a signal death discards.
+	// If the writer thread cannot be started, or after Destroy(), errors are written synchronously by opening and appending to the file.
+	// Error names are interned into ErrorHandles, which index an array of atomic occurrence counts. Logging by handle checks the
+	// per-error cap with one atomic read, and an error over its cap returns before any lock, string construction, or formatting.
+	// Hot call sites use PIX_ERROR_HANDLE and a string literal message, so dropped errors cost no allocation at all.
+	// Logging by name interns the name on every call, which hashes it under the mutex.
 	// 
 	// Philosophy:
     // Errors are expected to be the absolute exception, not the rule.
@@ -36,12 +68,45 @@ namespace pix
 		// Calling Init() again after successful initialization has no effect and returns true.
 		bool Init(const std::string& outputDirectory, int maxCountPerError);
 
+		// Writes all queued errors, stops the writer thread, and closes the log file.
+		// Call at shutdown, after all other threads that log errors have stopped. Errors logged afterwards are written synchronously.
+		// GameLoop calls Destroy() at the end of its destructor.
+		void Destroy();
+
+		// Blocks until all errors logged so far are written to the log file
+		void Flush();
+
+		// Writes the queued errors from the calling thread without allocating or blocking. Best-effort: gives up if the
+		// writer thread does not finish its current batch in time, e.g. because it is the crashing thread.
+		// Called by the crash handlers that Init() installs; custom crash handlers can call it as well.
+		// The process must end afterwards: no further errors are written.
+		void FlushOnCrash();
+
+		// Installs the std::terminate crash handler for the calling thread, if Init() installed the crash handlers.
+		// Call at the start of threads that log errors; GameLoop, JobSystem, and AsyncImageLoader do this for their threads.
+		void InstallThreadCrashHandler();
+
+		// Interns the error name and returns its handle; the same name always yields the same handle. Thread-safe.
+		// Returns the invalid handle if MAX_ERROR_NAMES distinct names are registered. Prefer PIX_ERROR_HANDLE at call sites.
+		ErrorHandle RegisterError(const std::string& errorName);
+
 		// Logs the last SDL error on the current thread, if present and allowed by the per-error cap
 		void LogSDLError(const std::string& errorName);
 
 		// Logs a custom error message under the given error name
 		void LogError(const std::string& errorName, const std::string& errorMessage);
 
+		// The following overloads take an interned error name. Errors with the invalid handle are ignored.
+		// The SDL error is cleared even if the error is over its cap.
+
+		void LogSDLError(ErrorHandle error);
+		void LogError(ErrorHandle error, const char* errorMessage);
+		void LogError(ErrorHandle error, const std::string& errorMessage);
+
+		// Returns false if the error has reached its per-error cap or the handle is invalid, true otherwise. Lock-free.
+		// Check this before building an expensive message; true does not guarantee that the next LogError() call is logged.
+		bool IsErrorLoggable(ErrorHandle error) const;
+
 		// Clears all in-memory error state and truncates the log file if possible
 		void ClearLog();
 
@@ -67,6 +132,9 @@ namespace pix
 		// Returns the number of logged occurrences for the given error name
 		int GetErrorCount(const std::string& errorName) const;
 
+		// Returns the number of logged occurrences for the error, or 0 for the invalid handle. Lock-free.
+		int GetErrorCount(ErrorHandle error) const;
+
 		// Returns the maximum number of occurrences logged per error name
 		int GetMaxCountPerError() const;
 
@@ -80,22 +148,73 @@ namespace pix
 
 		struct Error
 		{
-			Error(const std::string& name, const std::string& message);
+			Error(int errorID, const std::string& message);
 
-			std::string Name;
+			int ErrorID;
 			std::string Message;
 		};
 
+		// Node of the writer queue; an intrusive linked list, whose first node is a consumed stub owned by the writer thread
+		struct WriteRequest
+		{
+			WriteRequest* Next = nullptr;
+			std::string Text;
+			bool IsTruncate = false; // Truncates the log file instead of writing Text
+		};
+
 		static constexpr int MAX_LOG_ENTRIES = 10000;
+		static constexpr int MAX_ERROR_NAMES = 4096;
+		static constexpr int OVERFLOW_ERROR_ID = 0; // Registered first; reports that MAX_ERROR_NAMES is reached
+
+		ErrorLogger();
+		~ErrorLogger();
+
+		// Runs the writer thread: waits for queued write requests and writes them in batches
+		static int SDLCALL RunWriter(void* errorLogger);
 
-		ErrorLogger() = default;
-		~ErrorLogger() = default;
+		// Counts, stores, and writes the error unless it is over its cap or logging is off.
+		// The message is only copied and formatted if the error is logged.
+		void AddError(int errorID, const char* errorMessage);
+
+		// Queues the write request for the writer thread, or executes it synchronously if the writer thread is not running
+		void Write(const std::string& text, bool isTruncate);
+
+		// Called by any thread; lock-free
+		void PushWriteRequest(WriteRequest* writeRequest);
+
+		// Called by the writer thread only. Returns nullptr if the queue is empty.
+		WriteRequest* PopWriteRequest();
+
+		// Writes all queued requests; called by the writer thread, or by Destroy() after the writer thread has stopped.
+		// The caller must hold consumerLock_.
+		void ProcessWriteRequests();
+
+		void InstallCrashHandlers();
+		void UninstallCrashHandlers();
 
 		void WriteToFile(const std::string& input);
 		std::string FormatError(const std::string& errorName, const std::string& errorMessage) const;
 
 		std::vector<Error> errors_;  
-		std::unordered_map<std::string, int> errorCounts_;
+		std::deque<std::string> errorNames_;              // Indexed by error ID; a deque keeps the names in place as it grows
+		std::unordered_map<std::string, int> errorIDs_;
+		mutable SDL_atomic_t errorCounts_[MAX_ERROR_NAMES];     // Indexed by error ID; changed under stateMutex_, read lock-free
+		SDL_mutex* stateMutex_ = nullptr;                 // Guards errors_, errorNames_, errorIDs_, and changes of errorCounts_
+
+		// Writer thread
+		SDL_Thread* writerThread_ = nullptr;
+		SDL_sem* writerSemaphore_ = nullptr;      // Posted once per queued write request
+		SDL_mutex* flushMutex_ = nullptr;
+		SDL_cond* flushCondition_ = nullptr;      // Signaled by the writer thread after each batch
+		WriteRequest* queueHead_ = nullptr;       // Most recently pushed request; exchanged atomically by producers
+		WriteRequest* queueTail_ = nullptr;       // Consumed stub; only accessed by the writer thread
+		SDL_atomic_t queuedCount_;                // Write requests pushed so far
+		SDL_atomic_t writtenCount_;               // Write requests processed so far
+		SDL_atomic_t isWriterStopping_;
+		SDL_SpinLock consumerLock_ = 0;           // Held while the queue is consumed, so that FlushOnCrash() can take over from the writer thread
+		bool isCrashHandlerInstalled_ = false;
+		SDL_RWops* file_ = nullptr;               // Kept open while the writer thread runs; only accessed by the writer thread
+
 		std::string outputPath_;
 		int maxCountPerError_ = MAX_LOG_ENTRIES;
 		bool isLoggingEnabled_ = true;
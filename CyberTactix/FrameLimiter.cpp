@@ -0,0 +1,115 @@
+#include "FrameLimiter.h"
+#include <cmath>
+#include <SDL_timer.h>
+
+namespace pix
+{
+
+	FrameLimiter::FrameLimiter(double framesPerSecond)
+	{
+		SetTargetFramesPerSecond(framesPerSecond);
+	}
+
+	void FrameLimiter::Wait()
+	{
+		const double countsPerMillisecond = SDL_GetPerformanceFrequency() / 1000.0;
+
+		Uint64 now = SDL_GetPerformanceCounter();
+
+		if (IsEnabled())
+		{
+			const Uint64 framePeriod = (Uint64)(countsPerMillisecond * 1000.0 / framesPerSecond_);
+
+			// Restart the schedule on the first frame and after a missed frame period, e.g. after a loading hitch
+			if (frameDeadline_ == 0 || now > frameDeadline_ + framePeriod)
+				frameDeadline_ = now;
+			else
+				frameDeadline_ += framePeriod;
+
+			// Coarse sleep, leaving a margin for the expected overshoot
+			while (now < frameDeadline_)
+			{
+				const double remainingTime = (frameDeadline_ - now) / countsPerMillisecond;
+				const double sleepTime = std::floor(remainingTime - sleepOvershoot_ - 2.0 * sleepOvershootDeviation_);
+
+				if (sleepTime < 1.0) break;
+
+				SDL_Delay((Uint32)sleepTime);
+
+				const Uint64 sleepEnd = SDL_GetPerformanceCounter();
+
+				// Calibrate against the measured overshoot
+				const double overshoot = (sleepEnd - now) / countsPerMillisecond - sleepTime;
+				sleepOvershootDeviation_ += OVERSHOOT_SMOOTHING * (std::abs(overshoot - sleepOvershoot_) - sleepOvershootDeviation_);
+				sleepOvershoot_ += OVERSHOOT_SMOOTHING * (overshoot - sleepOvershoot_);
+
+				now = sleepEnd;
+			}
+
+			// Spin-wait for the rest of the frame
+			while (now < frameDeadline_)
+				now = SDL_GetPerformanceCounter();
+		}
+
+		if (prevFrameEnd_ != 0)
+		{
+			const double frameTime = (now - prevFrameEnd_) / countsPerMillisecond;
+
+			frameCount_++;
+			const double delta = frameTime - frameTimeMean_;
+			frameTimeMean_ += delta / frameCount_;
+			frameTimeSquaredDeviationSum_ += delta * (frameTime - frameTimeMean_);
+		}
+
+		prevFrameEnd_ = now;
+	}
+
+	void FrameLimiter::SetTargetFramesPerSecond(double framesPerSecond)
+	{
+		framesPerSecond_ = framesPerSecond > 0.0 ? framesPerSecond : 0.0;
+		frameDeadline_ = 0;
+	}
+
+	double FrameLimiter::GetTargetFramesPerSecond() const
+	{
+		return framesPerSecond_;
+	}
+
+	bool FrameLimiter::IsEnabled() const
+	{
+		return framesPerSecond_ > 0.0;
+	}
+
+	void FrameLimiter::ResetStatistics()
+	{
+		frameCount_ = 0;
+		frameTimeMean_ = 0.0;
+		frameTimeSquaredDeviationSum_ = 0.0;
+	}
+
+	double FrameLimiter::GetFrameTimeMean() const
+	{
+		return frameTimeMean_;
+	}
+
+	double FrameLimiter::GetFrameTimeVariance() const
+	{
+		return frameCount_ > 1 ? frameTimeSquaredDeviationSum_ / (frameCount_ - 1) : 0.0;
+	}
+
+	double FrameLimiter::GetFrameTimeStandardDeviation() const
+	{
+		return std::sqrt(GetFrameTimeVariance());
+	}
+
+	int FrameLimiter::GetFrameCount() const
+	{
+		return frameCount_;
+	}
+
+	double FrameLimiter::GetSleepOvershoot() const
+	{
+		return sleepOvershoot_;
+	}
+
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <SDL_stdinc.h>
+
+namespace pix
+{
+	// FrameLimiter caps the frame rate when no vsync paces the game loop, so the CPU does not spin at 100%.
+	//
+	// Technical note:
+	// Frames are scheduled against absolute deadlines, so sleep errors do not accumulate into a lower frame rate.
+	// Wait() sleeps coarsely with SDL_Delay() until shortly before the deadline and spin-waits the rest on SDL_GetPerformanceCounter().
+	// The spin margin is calibrated from the measured SDL_Delay() overshoot (average plus twice its mean deviation), so on systems
+	// with a precise timer most of the wait is spent sleeping, and on coarse timers the deadline is still met.
+	// SDL requests 1 ms timer resolution on Windows by default (SDL_HINT_TIMER_RESOLUTION).
+	// If a frame misses its deadline by more than a whole frame period, the schedule restarts at the current time instead of rushing
+	// the following frames.
+	//
+	// Usage:
+	// GameLoop calls Wait() after each SwapBuffers() if vsync is off; see LaunchConfigData::MaxFramesPerSecond.
+	// The frame time statistics cover all frames since the last ResetStatistics() and tell how even the pacing is.
+	class FrameLimiter
+	{
+	public:
+
+		// framesPerSecond <= 0 disables the limiter
+		explicit FrameLimiter(double framesPerSecond = 0.0);
+		~FrameLimiter() = default;
+
+		// Waits until the end of the current frame period. Returns immediately if the limiter is disabled.
+		void Wait();
+
+		// Sets the target frame rate and restarts the schedule. framesPerSecond <= 0 disables the limiter.
+		void SetTargetFramesPerSecond(double framesPerSecond);
+
+		double GetTargetFramesPerSecond() const;
+
+		bool IsEnabled() const;
+
+		// Clears the frame time statistics
+		void ResetStatistics();
+
+		// Returns the mean time between two Wait() returns in milliseconds
+		double GetFrameTimeMean() const;
+
+		// Returns the variance of the time between two Wait() returns in squared milliseconds
+		double GetFrameTimeVariance() const;
+
+		// Returns the standard deviation of the time between two Wait() returns in milliseconds
+		double GetFrameTimeStandardDeviation() const;
+
+		// Returns the number of frames covered by the statistics
+		int GetFrameCount() const;
+
+		// Returns the average amount by which SDL_Delay() oversleeps, in milliseconds
+		double GetSleepOvershoot() const;
+
+	private:
+
+		static constexpr double OVERSHOOT_SMOOTHING = 0.1;       // Weight of a new overshoot sample in the running averages
+		static constexpr double INITIAL_SLEEP_OVERSHOOT = 1.0;   // Assumed until the first sleeps are measured, in milliseconds
+
+		double framesPerSecond_ = 0.0;
+		Uint64 frameDeadline_ = 0;          // Performance counter value at which the current frame ends; 0 if not scheduled yet
+		Uint64 prevFrameEnd_ = 0;           // Performance counter value of the last Wait() return; 0 if none
+		double sleepOvershoot_ = INITIAL_SLEEP_OVERSHOOT;
+		double sleepOvershootDeviation_ = 0.0;
+
+		// Welford's online algorithm, numerically stable for long runs
+		int    frameCount_ = 0;
+		double frameTimeMean_ = 0.0;
+		double frameTimeSquaredDeviationSum_ = 0.0;
+	};
+}
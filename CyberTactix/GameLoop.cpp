@@ -2,11 +2,14 @@
 #include "ErrorLogger.h"
 #include <SDL_ttf.h>
 #include <SDL_image.h>
+#include <SDL_cpuinfo.h>
 #include "Window.h"
 #include "Renderer.h"
 #include "Audio.h"
 #include "Input.h"
+#include "DeviceInput.h"
 #include "PixMath.h"
+#include "Profiler.h"
 
 //#include <steam_api.h>
 
@@ -22,18 +25,30 @@ namespace pix
 		if (!SDL_SetHint(SDL_HINT_WINDOWS_DPI_AWARENESS, "permonitorv2"))
 			errorLogger.LogError("GameLoop::GameLoop() - SDL_SetHint() failure", "Failed to set permonitorv2 value!");
 
+		// Headless mode runs without display and sound device. Driver hints must be set before SDL_Init()!
+		if (configData.IsHeadless)
+		{
+			if (!SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy") || !SDL_SetHint(SDL_HINT_AUDIODRIVER, "dummy"))
+				errorLogger.LogError("GameLoop::GameLoop() - SDL_SetHint() failure", "Failed to select the dummy video and audio drivers!");
+		}
+
 		if (SDL_Init(SDL_INIT_EVERYTHING) != 0)
 		  errorLogger.LogSDLError("GameLoop::GameLoop() - SDL_Init() failure");
 
 		LaunchConfig::Get().Init(configData);
 
-		if (!Window::Get().Init(appName, configData.LogicalResolutionWidth, configData.LogicalResolutionHeight, configData.IsFullscreen))
+		// Leave one core to the main thread, and one more to the simulation thread in pipelined mode
+		const int workerCount = SDL_GetCPUCount() - (configData.IsPipelined ? 2 : 1);
+		jobSystem_.reset(new JobSystem(workerCount > 0 ? workerCount : 0));
+
+		// In headless mode, the window only exists on the dummy video driver, so the Window API stays usable
+		if (!Window::Get().Init(appName, configData.LogicalResolutionWidth, configData.LogicalResolutionHeight, configData.IsFullscreen && !configData.IsHeadless))
 		{
 			Quit();  // Having no window is a fatal error
 			return;
 		}
 
-		if (!Renderer::Get().Init(configData.LogicalResolutionWidth, configData.LogicalResolutionHeight, configData.IsIntegerScale, configData.IsLinearFilter, configData.IsVsync))
+		if (!Renderer::Get().Init(configData.LogicalResolutionWidth, configData.LogicalResolutionHeight, configData.IsIntegerScale, configData.IsLinearFilter, configData.IsVsync, configData.IsHeadless))
 		{
 			Quit(); // Having no renderer is a fatal error
 			return;
@@ -58,10 +73,17 @@ namespace pix
 
 		SetUpdateLoopScheduler(nullptr);
 
+		// Headless runs are benchmarks and regression runs, which must not be capped
+		frameLimiter_.SetTargetFramesPerSecond(configData.IsHeadless ? 0.0f : configData.MaxFramesPerSecond);
+
+		isPipelined_ = configData.IsPipelined;
+
+		DeviceInput::Get().SetEventCapture(configData.IsInputEventCapture);
+
 		//Gamepad::addGamepadsFromFile("gamecontrollerdb.txt");
 		GamepadInput::Get().AddAllGamepads();
 
-		if (SDL_ShowCursor(SDL_DISABLE) < 0)
+		if (!configData.IsHeadless && SDL_ShowCursor(SDL_DISABLE) < 0)
 			errorLogger.LogSDLError("GameLoop::GameLoop() - SDL_ShowCursor(SDL_DISABLE) failure");
 
 		// if(!SteamAPI_Init()) Display::markClosed();
@@ -69,6 +91,8 @@ namespace pix
 
 	GameLoop::~GameLoop() 
 	{
+		jobSystem_.reset();
+
 		GamepadInput::Get().RemoveAllGamepads();
 
 		Audio::Get().Destroy();
@@ -81,67 +105,77 @@ namespace pix
 		Window::Get().Destroy();
 
 		SDL_Quit();
+
+		ErrorLogger::Get().Destroy(); // Last, so that shutdown errors are written
 	}
 
 
 	void GameLoop::Run() 
 	{
-		Uint64 timeStamp = SDL_GetTicks64();
-		Uint64 prevTimeStamp;
+		// SDL_GetTicks64() only has millisecond resolution, which quantizes frame deltas and causes jitter at high refresh rates
+		frameTimeStamp_ = SDL_GetPerformanceCounter();
 
-		while (isRunning_)
+		if (isPipelined_ && StartSimulationThread())
 		{
-			prevTimeStamp = timeStamp;
-			timeStamp = SDL_GetTicks64();
-			deltaTime_ = (float)(timeStamp - prevTimeStamp); // Effectively lossless for normal frame deltas
-
-			int updateCount = 1;
-			if (updateLoopScheduler_)
-			{
-				updateCount = updateLoopScheduler_->Update(deltaTime_);
-				updateCount = GetClamped(updateCount, 0, 100); // Final safety cap against invalid scheduler output
-			}
-
-			UpdateInterpolationAlpha();
+			RunPipelined();
+			StopSimulationThread();
+		}
+		else
+		{
+			isPipelined_ = false;
+			RunSequential();
+		}
 
-			// Poll current device input state and handle events
-			HandleEvents();
-			MouseInput::Get().Update();
+		//SteamAPI_Shutdown();
+	}
 
-			for (int i = 0; i < updateCount; i++)
-			{
-				// Ensure input is pumped for every Update(), not just once per frame, so that Update() gets the freshest device input state available
-				if (i > 0)
-				{
-					SDL_PumpEvents();
-					MouseInput::Get().Update();
-				}
+	void GameLoop::PublishSnapshot()
+	{
+	}
 
-				Update(); // VIRTUAL				
+	void GameLoop::OnReplayFinished()
+	{
+		Quit();
+	}
 
-				MouseInput::Get().EndUpdate();
-			}
+	void GameLoop::SetUpdateLoopScheduler(AbstractUpdateLoopScheduler* updateLoopScheduler)
+	{
+		updateLoopScheduler_ = updateLoopScheduler;
+	}
 
-			Render(); // VIRTUAL 
+	void GameLoop::Quit()
+	{
+		isRunning_ = false;
+	}
 
-			MouseInput::Get().EndRender();
+	void GameLoop::SetInputRecorder(InputRecorder* inputRecorder)
+	{
+		inputRecorder_ = inputRecorder;
+	}
 
-			Renderer::Get().SwapBuffers(); // Vsynced double buffering
+	void GameLoop::SetInputReplay(InputReplay* inputReplay)
+	{
+		inputReplay_ = inputReplay;
+	}
 
-			// SDL_Delay(1); // Experimental, helps to keep gameloop smooth on some integrated cards for unknown reason
-		}
+	void GameLoop::SetReplayUpdatesPerFrame(int updateCount)
+	{
+		replayUpdatesPerFrame_ = GetClamped(updateCount, 0, 100);
+	}
 
-		//SteamAPI_Shutdown();
+	int GameLoop::GetReplayUpdatesPerFrame() const
+	{
+		return replayUpdatesPerFrame_;
 	}
 
-	void GameLoop::SetUpdateLoopScheduler(AbstractUpdateLoopScheduler* updateLoopScheduler)
+	InputRecorder* GameLoop::GetInputRecorder() const
 	{
-		updateLoopScheduler_ = updateLoopScheduler;
+		return inputRecorder_;
 	}
 
-	void GameLoop::Quit()
+	InputReplay* GameLoop::GetInputReplay() const
 	{
-		isRunning_ = false;
+		return inputReplay_;
 	}
 
 	AbstractUpdateLoopScheduler* GameLoop::GetUpdateLoopScheduler() const
@@ -149,7 +183,22 @@ namespace pix
 		return updateLoopScheduler_;
 	}
 
-	float GameLoop::GetDeltaTime() const
+	JobSystem& GameLoop::GetJobSystem()
+	{
+		return *jobSystem_;
+	}
+
+	FrameLimiter& GameLoop::GetFrameLimiter()
+	{
+		return frameLimiter_;
+	}
+
+	InputLatencyMeter& GameLoop::GetInputLatencyMeter()
+	{
+		return inputLatencyMeter_;
+	}
+
+	double GameLoop::GetDeltaTime() const
 	{
 		return deltaTime_;
 	}
@@ -164,6 +213,11 @@ namespace pix
 		return isRunning_;
 	}
 
+	bool GameLoop::IsPipelined() const
+	{
+		return isPipelined_;
+	}
+
 	// On Windows, the output path might look like this: C:\\Users\\bob\\AppData\\Roaming\\companyName\\appName\\ErrorLog.txt
 	std::string GameLoop::GetPrefPath(const std::string& companyName, const std::string& appName)
 	{
@@ -176,6 +230,234 @@ namespace pix
 		return result;
 	}
 
+	void GameLoop::RunSequential()
+	{
+		while (isRunning_)
+		{
+			const int updateCount = UpdateFrameTiming();
+
+			interpolationAlpha_ = ComputeInterpolationAlpha();
+
+			// Poll current device input state and handle events
+			{
+				PIX_PROFILE_ZONE("GameLoop::HandleEvents");
+				HandleEvents();
+				MouseInput::Get().Update();
+				DeviceInput::Get().Update();
+
+				if (updateCount > 0) inputLatencyMeter_.AddEvents(DeviceInput::Get().GetEvents()); // Without an update, no frame reflects the events
+			}
+
+			jobSystem_->ProcessMainThreadTasks();
+
+			for (int i = 0; i < updateCount; i++)
+			{
+				PIX_PROFILE_ZONE("GameLoop::Update");
+
+				// Ensure input is pumped for every Update(), not just once per frame, so that Update() gets the freshest device input state available
+				if (i > 0)
+				{
+					SDL_PumpEvents();
+					MouseInput::Get().Update();
+					DeviceInput::Get().Update();
+					inputLatencyMeter_.AddEvents(DeviceInput::Get().GetEvents());
+				}
+
+				if (!ProcessUpdateInput()) break;
+
+				Update(); // VIRTUAL				
+
+				MouseInput::Get().EndUpdate();
+			}
+
+			{
+				PIX_PROFILE_ZONE("GameLoop::Render");
+
+				inputLatencyMeter_.BeginRender();
+
+				Renderer::Get().SyncStateCache(); // SDL may have changed the render scale while pumping events, e.g. on window resize
+
+				Render(); // VIRTUAL 
+
+				MouseInput::Get().EndRender();
+			}
+
+			EndFrame();
+		}
+	}
+
+	void GameLoop::RunPipelined()
+	{
+		float pendingInterpolationAlpha = 1.0f; // Belongs to the updates running on the simulation thread
+
+		while (true)
+		{
+			// Sync point: the simulation thread has finished the updates of the previous frame and stays idle until it is resumed
+			{
+				PIX_PROFILE_ZONE("GameLoop::WaitForSimulation");
+				SDL_SemWait(simulationDoneSemaphore_);
+			}
+
+			if (!isRunning_) break;
+
+			// The alpha is published together with the state it belongs to
+			interpolationAlpha_ = pendingInterpolationAlpha;
+
+			{
+				PIX_PROFILE_ZONE("GameLoop::PublishSnapshot");
+				PublishSnapshot(); // VIRTUAL
+			}
+
+			inputLatencyMeter_.BeginRender(); // The published state reflects the events of the previous sync point
+
+			MouseInput::Get().EndRender();
+
+			simulationUpdateCount_ = UpdateFrameTiming();
+
+			pendingInterpolationAlpha = ComputeInterpolationAlpha();
+
+			// Input is pumped on the main thread while the simulation is idle, and stays unchanged during the updates
+			{
+				PIX_PROFILE_ZONE("GameLoop::HandleEvents");
+				HandleEvents();
+				MouseInput::Get().Update();
+				DeviceInput::Get().Update();
+
+				if (simulationUpdateCount_ > 0) inputLatencyMeter_.AddEvents(DeviceInput::Get().GetEvents());
+			}
+
+			jobSystem_->ProcessMainThreadTasks();
+
+			SDL_SemPost(simulationSemaphore_); // Resume the simulation
+
+			{
+				PIX_PROFILE_ZONE("GameLoop::Render");
+
+				Renderer::Get().SyncStateCache(); // SDL may have changed the render scale while pumping events, e.g. on window resize
+
+				Render(); // VIRTUAL 
+			}
+
+			EndFrame();
+		}
+	}
+
+	int GameLoop::UpdateFrameTiming()
+	{
+		const double countsPerMillisecond = SDL_GetPerformanceFrequency() / 1000.0;
+
+		const Uint64 prevTimeStamp = frameTimeStamp_;
+		frameTimeStamp_ = SDL_GetPerformanceCounter();
+		deltaTime_ = (frameTimeStamp_ - prevTimeStamp) / countsPerMillisecond; // Integer counter difference first, so precision does not degrade with uptime
+
+		// A replay running faster than real time must not feed the scheduler, which would drop the backlog as overload
+		isReplayPacedFrame_ = inputReplay_ && replayUpdatesPerFrame_ > 0;
+
+		if (isReplayPacedFrame_) return replayUpdatesPerFrame_;
+
+		int updateCount = 1;
+		if (updateLoopScheduler_)
+		{
+			updateCount = updateLoopScheduler_->Update(deltaTime_);
+			updateCount = GetClamped(updateCount, 0, 100); // Final safety cap against invalid scheduler output
+		}
+
+		return updateCount;
+	}
+
+	void GameLoop::EndFrame()
+	{
+		{
+			PIX_PROFILE_ZONE("GameLoop::SwapBuffers");
+			Renderer::Get().SwapBuffers(); // Vsynced double buffering
+		}
+
+		inputLatencyMeter_.EndPresent();
+
+		// Without vsync, SwapBuffers() returns immediately; sleep instead of spinning at full CPU load
+		if (!Renderer::Get().IsVsync() && !isReplayPacedFrame_)
+		{
+			PIX_PROFILE_ZONE("GameLoop::FrameLimiter");
+			frameLimiter_.Wait();
+		}
+
+		PIX_PROFILE_FRAME();
+	}
+
+	bool GameLoop::StartSimulationThread()
+	{
+		simulationSemaphore_ = SDL_CreateSemaphore(0);
+		simulationDoneSemaphore_ = SDL_CreateSemaphore(1); // No updates pending before the first frame
+
+		if (!simulationSemaphore_ || !simulationDoneSemaphore_)
+		{
+			ErrorLogger::Get().LogSDLError("GameLoop::StartSimulationThread() - SDL_CreateSemaphore() failure");
+			StopSimulationThread();
+			return false;
+		}
+
+		isSimulationStopping_ = false;
+		simulationThread_ = SDL_CreateThread(RunSimulation, "PixSimulation", this);
+
+		if (!simulationThread_)
+		{
+			ErrorLogger::Get().LogSDLError("GameLoop::StartSimulationThread() - SDL_CreateThread() failure");
+			StopSimulationThread();
+			return false;
+		}
+
+		return true;
+	}
+
+	void GameLoop::StopSimulationThread()
+	{
+		// Only called while the simulation thread is idle at the sync point
+		if (simulationThread_)
+		{
+			isSimulationStopping_ = true;
+			SDL_SemPost(simulationSemaphore_);
+			SDL_WaitThread(simulationThread_, nullptr);
+			simulationThread_ = nullptr;
+		}
+
+		SDL_DestroySemaphore(simulationDoneSemaphore_);
+		SDL_DestroySemaphore(simulationSemaphore_);
+		simulationDoneSemaphore_ = nullptr;
+		simulationSemaphore_ = nullptr;
+	}
+
+	int SDLCALL GameLoop::RunSimulation(void* gameLoop)
+	{
+		GameLoop* self = (GameLoop*)gameLoop;
+
+		ErrorLogger::Get().InstallThreadCrashHandler();
+
+		while (true)
+		{
+			SDL_SemWait(self->simulationSemaphore_);
+
+			if (self->isSimulationStopping_) break;
+
+			for (int i = 0; i < self->simulationUpdateCount_; i++)
+			{
+				PIX_PROFILE_ZONE("GameLoop::Update");
+
+				if (!self->ProcessUpdateInput()) break;
+
+				self->Update(); // VIRTUAL
+
+				MouseInput::Get().EndUpdate();
+
+				// The input was captured once for all updates of the frame; its events belong to the first one only
+				if (i == 0) DeviceInput::Get().ClearEvents();
+			}
+
+			SDL_SemPost(self->simulationDoneSemaphore_);
+		}
+
+		return 0;
+	}
+
 	void GameLoop::HandleEvents()
 	{
 		SDL_Event  event;
@@ -199,20 +481,42 @@ namespace pix
 			{
 				GamepadInput::Get().AddGamepad(event.cdevice.which);
 			}
+			else
+			{
+				// Key, button, and gamepad state is polled; their events only provide timestamps if event capture is on
+				DeviceInput::Get().HandleEvent(event);
+			}
 		}
 	}
 
-	void GameLoop::UpdateInterpolationAlpha() 
+	bool GameLoop::ProcessUpdateInput()
 	{
-		if (!updateLoopScheduler_)
+		if (inputReplay_)
 		{
-			interpolationAlpha_ = 1.0f;
-			return;
+			if (!inputReplay_->ReadUpdate())
+			{
+				inputReplay_ = nullptr;
+				OnReplayFinished(); // VIRTUAL
+				return false;
+			}
+
+			DeviceInput::Get().SetState(inputReplay_->GetDeviceState());
 		}
 
-		interpolationAlpha_ = GetSafeDivision(updateLoopScheduler_->GetUnprocessedTime(),updateLoopScheduler_->GetUpdatePeriod());
+		if (inputRecorder_)
+			inputRecorder_->RecordUpdate(DeviceInput::Get().GetState());
+
+		return true;
+	}
+
+	float GameLoop::ComputeInterpolationAlpha() const
+	{
+		if (!updateLoopScheduler_ || isReplayPacedFrame_)
+			return 1.0f;
+
+		const double interpolationAlpha = GetSafeDivision(updateLoopScheduler_->GetUnprocessedTime(), updateLoopScheduler_->GetUpdatePeriod());
 
-		interpolationAlpha_ = GetClamped(interpolationAlpha_, 0.0f, 1.0f);
+		return (float)GetClamped(interpolationAlpha, 0.0, 1.0);
 	}
 
 }
@@ -1,8 +1,15 @@
 #pragma once
 
 #include <string>
+#include <memory>
+#include <SDL_thread.h>
+#include <SDL_mutex.h>
 #include "LaunchConfig.h"
 #include "UpdateLoopScheduler.h"
+#include "FrameLimiter.h"
+#include "JobSystem.h"
+#include "InputRecording.h"
+#include "InputLatencyMeter.h"
 
 namespace pix
 {
@@ -13,7 +20,25 @@ namespace pix
 	// SDL events are polled and processed at the beginning of each frame.
     // Before each additional fixed Update() in the same frame, SDL_PumpEvents() refreshes SDL's internal input state,
     // so simulation consumes the freshest available physical input.
+	// Each time input is refreshed, DeviceInput captures a snapshot of all device state, which the input pumps of ObjectInput read.
+	// With LaunchConfigData::IsInputEventCapture, the polled key, button, and gamepad events are also passed to DeviceInput with their
+	// timestamps, and InputLatencyMeter measures the time from these events to the present of the frame that reflects them.
     // Mouse wheel input is event-based and is processed only during the frame event poll.
+	// With an InputReplay set, the recorded DeviceState replaces the captured one before every Update(), and with an InputRecorder set,
+	// the DeviceState of every Update() is recorded; see InputRecorder.
+	// By default, replays are paced like live play. SetReplayUpdatesPerFrame() runs a fixed number of updates per frame instead,
+	// bypassing the update loop scheduler and the frame limiter; in headless mode, nothing else paces the loop.
+	//
+	// Pipelined mode (LaunchConfigData::IsPipelined):
+	// The updates of frame N+1 run on a simulation thread while the main thread renders frame N, so frame time becomes
+	// the longer of update and render time instead of their sum. Both threads meet once per frame at a sync point where the
+	// simulation is idle. There, PublishSnapshot() copies what Render() needs (e.g. Transform and GetPrevTransform() of all
+	// visible objects) into render-side state, and events are polled; the interpolation alpha is published along with the snapshot.
+	// Rules in pipelined mode:
+	// - Update() runs on the simulation thread and must not call Renderer, Window, Audio or other SDL video functions.
+	// - Render() must only read the snapshot, not simulation state or input, which the simulation thread is using.
+	// - Input is polled once per frame; additional updates in the same frame see the same input state, but no captured events.
+	// - Rendering shows the simulation state one frame later than in sequential mode.
 	// 
 	// Initialization policy:
     // Non-critical subsystem failures are logged but do not abort startup.
@@ -42,6 +67,15 @@ namespace pix
 		// Render() is called exactly once per frame
 		virtual void Render() = 0;
 
+		// Pipelined mode only: called on the main thread once per frame while the simulation thread is idle.
+		// Copy the state that Render() needs here. GetInterpolationAlpha() already returns the alpha for this state.
+		// The default implementation does nothing.
+		virtual void PublishSnapshot();
+
+		// Called on the thread running Update() when the input replay has no more updates, instead of the next Update().
+		// The replay is detached before the call. The default implementation calls Quit(), which ends headless regression runs.
+		virtual void OnReplayFinished();
+
 		// Sets the update-loop scheduler. It can be swapped at runtime.
         // GameLoop does not own the scheduler; lifetime is managed by the caller or derived class.
         // If updateLoopScheduler is nullptr, Update() is called once per frame (variable update loop).
@@ -50,11 +84,46 @@ namespace pix
 		// Ends the Run() loop at the end of the current iteration
 		void Quit();
 
+		// Sets the recorder that receives the DeviceState of every Update(), or nullptr to stop recording.
+		// GameLoop does not own the recorder. Call before Run() or from Update().
+		void SetInputRecorder(InputRecorder* inputRecorder);
+
+		// Sets the replay whose recorded DeviceState replaces device input before every Update(), or nullptr to use the devices again.
+		// GameLoop does not own the replay. Call before Run() or from Update().
+		void SetInputReplay(InputReplay* inputReplay);
+
+		// Sets the number of updates per frame while an input replay is set, regardless of the elapsed time.
+		// The update loop scheduler and the frame limiter are bypassed, and the interpolation alpha is 1.
+		// 0 (default) paces replays by the scheduler like live play.
+		void SetReplayUpdatesPerFrame(int updateCount);
+
+		int GetReplayUpdatesPerFrame() const;
+
+		// Returns the input recorder, or nullptr if none is assigned
+		InputRecorder* GetInputRecorder() const;
+
+		// Returns the input replay, or nullptr if none is assigned or the replay has finished
+		InputReplay* GetInputReplay() const;
+
 		// Returns the update loop scheduler, or nullptr if none is assigned
 		AbstractUpdateLoopScheduler* GetUpdateLoopScheduler() const;
+
+		// Returns the job system for fanning out work in Update() and Render().
+		// It has one worker per additional CPU core, minus one for the simulation thread in pipelined mode.
+		// Tasks queued with JobSystem::RunOnMainThread() run once per frame on the main thread, after events are handled.
+		JobSystem& GetJobSystem();
+
+		// Returns the frame limiter that caps the frame rate while vsync is off.
+		// It is set up from LaunchConfigData::MaxFramesPerSecond, or disabled in headless mode; the target can be changed at runtime.
+		FrameLimiter& GetFrameLimiter();
+
+		// Returns the meter for the time from input events to the present of the frame that reflects them.
+		// It only receives events if LaunchConfigData::IsInputEventCapture is set.
+		InputLatencyMeter& GetInputLatencyMeter();
 		
-		// Returns the time delta between the start of this frame and the last one in milliseconds
-		float GetDeltaTime() const;
+		// Returns the time delta between the start of this frame and the last one in milliseconds.
+		// Measured with SDL_GetPerformanceCounter(), so it has sub-millisecond resolution.
+		double GetDeltaTime() const;
 		
 		// Returns the normalized unprocessed time for this frame. 
 		// This value is already computed at the beginning of the frame, before the updates are processed.
@@ -64,15 +133,60 @@ namespace pix
 		
 		bool IsRunning() const;
 
+		// Returns true if updates run on the simulation thread; false if pipelined mode is off or the thread could not be started
+		bool IsPipelined() const;
+
 	private:
 
+		// Runs the simulation thread: waits at the sync point, then executes the updates of one frame
+		static int SDLCALL RunSimulation(void* gameLoop);
+
+		void RunSequential();
+		void RunPipelined();
+
+		// Measures the frame delta and returns the number of updates for this frame
+		int UpdateFrameTiming();
+
+		// Presents the frame and waits for the frame limiter
+		void EndFrame();
+
+		// Returns true if the simulation thread is running, false otherwise
+		bool StartSimulationThread();
+		void StopSimulationThread();
+
 		void HandleEvents();
-		void UpdateInterpolationAlpha();
+
+		// Applies the replayed input and records the input of the next Update().
+		// Returns false if the replay has finished and the update must be skipped.
+		bool ProcessUpdateInput();
+		float ComputeInterpolationAlpha() const;
 
 		// Non-owning
 		AbstractUpdateLoopScheduler* updateLoopScheduler_ = nullptr;
 
-		float deltaTime_ = 0.0f; // in milliseconds
+		FrameLimiter frameLimiter_;
+
+		InputLatencyMeter inputLatencyMeter_;
+
+		// Non-owning
+		InputRecorder* inputRecorder_ = nullptr;
+		InputReplay* inputReplay_ = nullptr;
+		int replayUpdatesPerFrame_ = 0;
+		bool isReplayPacedFrame_ = false; // Set by UpdateFrameTiming(), so the main thread need not read inputReplay_ while the simulation runs
+
+		std::unique_ptr<JobSystem> jobSystem_; // Created after SDL_Init(), so that its errors are logged
+
+		// Pipelined mode; the simulation thread only accesses GameLoop state between the two semaphores
+		SDL_Thread* simulationThread_ = nullptr;
+		SDL_sem* simulationSemaphore_ = nullptr;      // Posted by the main thread to run the updates of a frame
+		SDL_sem* simulationDoneSemaphore_ = nullptr;  // Posted by the simulation thread when the updates are done
+		int simulationUpdateCount_ = 0;
+		bool isSimulationStopping_ = false;
+		bool isPipelined_ = false;
+
+		Uint64 frameTimeStamp_ = 0; // Performance counter value at the start of the current frame
+
+		double deltaTime_ = 0.0; // in milliseconds
 		float interpolationAlpha_ = 1.0f;
 		bool isRunning_ = true;
 	};
@@ -0,0 +1,317 @@
+#include "GlyphAtlas.h"
+#include "ImageTexture.h"
+#include "SpriteMeshOps.h"
+#include "UV.h"
+#include "Renderer.h"
+#include "ErrorLogger.h"
+
+namespace pix
+{
+
+	GlyphAtlas::GlyphAtlas(TTF_Font* font, bool renderBlended, int atlasWidth, int atlasHeight) :
+		font_(font),
+		atlasWidth_(atlasWidth),
+		atlasHeight_(atlasHeight),
+		renderBlended_(renderBlended)
+	{
+		if (!font_)
+			ErrorLogger::Get().LogError("GlyphAtlas::GlyphAtlas() failure", "No TTF_Font provided!");
+
+		if (atlasTexture_.Realloc(atlasWidth_, atlasHeight_))
+			atlasTexture_.SetBlendMode(SDL_BLENDMODE_BLEND);
+
+		Reset();
+	}
+
+	bool GlyphAtlas::AddGlyphs(const std::string& text)
+	{
+		bool isComplete = true;
+
+		int index = 0;
+		const int length = text.size();
+
+		while (index < length)
+		{
+			const Uint32 codepoint = DecodeUTF8(text, index);
+
+			if (codepoint == '\n' || glyphs_.find(codepoint) != glyphs_.end())
+				continue;
+
+			if (!font_ || !TTF_GlyphIsProvided32(font_, codepoint))
+			{
+				isComplete = false;
+				continue;
+			}
+
+			Glyph glyph;
+			if (!RasterizeGlyph(codepoint, glyph))
+				isComplete = false;
+
+			glyphs_[codepoint] = glyph;
+		}
+
+		return isComplete;
+	}
+
+	void GlyphAtlas::Reset()
+	{
+		glyphs_.clear();
+
+		shelfX_ = GLYPH_PADDING;
+		shelfY_ = GLYPH_PADDING;
+		shelfHeight_ = 0;
+
+		if (!atlasTexture_.IsInitialized()) return;
+
+		// Clear the atlas to fully transparent pixels
+		Renderer& renderer = Renderer::Get();
+
+		Uint8 r, g, b, a;
+		renderer.GetRenderColor(r, g, b, a);
+		TargetTexture* prevRenderTarget = renderer.GetRenderTarget();
+
+		renderer.SetRenderTarget(&atlasTexture_);
+		renderer.SetRenderColor(0, 0, 0, 0);
+		renderer.Clear();
+
+		renderer.SetRenderColor(r, g, b, a);
+		renderer.SetRenderTarget(prevRenderTarget);
+	}
+
+	float GlyphAtlas::RenderText(SpriteMeshRenderer2D& spriteRenderer, const std::string& text, Vec2f position, float scale, SDL_Color color)
+	{
+		return LayoutText(&spriteRenderer, text, position, scale, color).X;
+	}
+
+	Vec2f GlyphAtlas::GetTextSize(const std::string& text)
+	{
+		return LayoutText(nullptr, text, Vec2f(0.0f, 0.0f), 1.0f, SDL_Color{ 255, 255, 255, 255 });
+	}
+
+	TargetTexture& GlyphAtlas::GetTexture()
+	{
+		return atlasTexture_;
+	}
+
+	int GlyphAtlas::GetLineHeight() const
+	{
+		return font_ ? TTF_FontLineSkip(font_) : 0;
+	}
+
+	int GlyphAtlas::GetGlyphCount() const
+	{
+		return glyphs_.size();
+	}
+
+	bool GlyphAtlas::IsInitialized() const
+	{
+		return font_ && atlasTexture_.IsInitialized();
+	}
+
+
+
+	const GlyphAtlas::Glyph* GlyphAtlas::GetGlyph(Uint32 codepoint)
+	{
+		auto it = glyphs_.find(codepoint);
+
+		if (it != glyphs_.end())
+			return &(it->second);
+
+		if (!font_ || !TTF_GlyphIsProvided32(font_, codepoint))
+			return nullptr;
+
+		Glyph& glyph = glyphs_[codepoint];
+		RasterizeGlyph(codepoint, glyph);
+
+		return &glyph;
+	}
+
+	bool GlyphAtlas::RasterizeGlyph(Uint32 codepoint, Glyph& glyph)
+	{
+		glyph.IsVisible = false;
+
+		int minX, maxX, minY, maxY, advance;
+
+		if (TTF_GlyphMetrics32(font_, codepoint, &minX, &maxX, &minY, &maxY, &advance) != 0)
+		{
+			ErrorLogger::Get().LogSDLError("GlyphAtlas::RasterizeGlyph() - TTF_GlyphMetrics32() failure");
+			return false;
+		}
+
+		glyph.Advance = advance;
+
+		// Glyphs without pixels, such as spaces, only advance the pen
+		if (maxX <= minX || maxY <= minY)
+			return true;
+
+		if (!atlasTexture_.IsInitialized())
+			return false;
+
+		const SDL_Color white = { 255, 255, 255, 255 };
+
+		SDL_Surface* glyphSurface = renderBlended_ ? TTF_RenderGlyph32_Blended(font_, codepoint, white) : TTF_RenderGlyph32_Solid(font_, codepoint, white);
+
+		if (!glyphSurface)
+		{
+			ErrorLogger::Get().LogSDLError("GlyphAtlas::RasterizeGlyph() - TTF_RenderGlyph32() failure");
+			return false;
+		}
+
+		const int width = glyphSurface->w;
+		const int height = glyphSurface->h;
+
+		// Shelf packing: start a new shelf below the current one if the glyph does not fit horizontally
+		if (shelfX_ + width + GLYPH_PADDING > atlasWidth_)
+		{
+			shelfX_ = GLYPH_PADDING;
+			shelfY_ += shelfHeight_ + GLYPH_PADDING;
+			shelfHeight_ = 0;
+		}
+
+		if (width + 2 * GLYPH_PADDING > atlasWidth_ || shelfY_ + height + GLYPH_PADDING > atlasHeight_)
+		{
+			SDL_FreeSurface(glyphSurface);
+			ErrorLogger::Get().LogError("GlyphAtlas::RasterizeGlyph() failure", "The glyph atlas is full!");
+			return false;
+		}
+
+		ImageTexture glyphTexture;
+		const bool isUploaded = glyphTexture.Reload(glyphSurface);
+
+		SDL_FreeSurface(glyphSurface);
+
+		if (!isUploaded) return false;
+
+		// Copy the glyph pixels as they are, including alpha
+		glyphTexture.SetBlendMode(SDL_BLENDMODE_NONE);
+
+		const SDL_FRect destinationRect = { (float)shelfX_, (float)shelfY_, (float)width, (float)height };
+
+		Renderer& renderer = Renderer::Get();
+		TargetTexture* prevRenderTarget = renderer.GetRenderTarget();
+
+		renderer.SetRenderTarget(&atlasTexture_);
+		const bool isRendered = renderer.Render(glyphTexture, nullptr, &destinationRect);
+		renderer.SetRenderTarget(prevRenderTarget);
+
+		if (!isRendered)
+		{
+			ErrorLogger::Get().LogSDLError("GlyphAtlas::RasterizeGlyph() - Renderer::Render() failure");
+			return false;
+		}
+
+		// The glyph surface starts at the pen position, or further left if the glyph overhangs to the left
+		const float offsetX = minX < 0 ? (float)minX : 0.0f;
+
+		const UVRect uvRect((float)shelfX_ / atlasWidth_, (float)shelfY_ / atlasHeight_, (float)(shelfX_ + width) / atlasWidth_, (float)(shelfY_ + height) / atlasHeight_);
+
+		glyph.Mesh = GetSpriteMesh(Vec2f(offsetX, 0.0f), Vec2f(offsetX + width, (float)height), uvRect);
+		glyph.IsVisible = true;
+
+		shelfX_ += width + GLYPH_PADDING;
+		if (height > shelfHeight_) shelfHeight_ = height;
+
+		return true;
+	}
+
+	Vec2f GlyphAtlas::LayoutText(SpriteMeshRenderer2D* spriteRenderer, const std::string& text, Vec2f position, float scale, SDL_Color color)
+	{
+		const float lineHeight = GetLineHeight() * scale;
+
+		Vec2f penPosition = position;
+		float maxLineWidth = 0.0f;
+		int lineCount = 1;
+		Uint32 prevCodepoint = 0;
+
+		int index = 0;
+		const int length = text.size();
+
+		while (index < length)
+		{
+			const Uint32 codepoint = DecodeUTF8(text, index);
+
+			if (codepoint == '\n')
+			{
+				if (penPosition.X - position.X > maxLineWidth) maxLineWidth = penPosition.X - position.X;
+
+				penPosition.X = position.X;
+				penPosition.Y += lineHeight;
+				prevCodepoint = 0;
+				lineCount++;
+				continue;
+			}
+
+			const Glyph* glyph = GetGlyph(codepoint);
+
+			if (!glyph)
+			{
+				prevCodepoint = 0;
+				continue;
+			}
+
+			if (prevCodepoint != 0)
+				penPosition.X += TTF_GetFontKerningSizeGlyphs32(font_, prevCodepoint, codepoint) * scale;
+
+			if (spriteRenderer && glyph->IsVisible)
+			{
+				SpriteMesh mesh = glyph->Mesh;
+
+				for (int i = 0; i < SpriteMesh::VERTEX_COUNT; i++)
+					mesh.Vertices[i].Color = color;
+
+				spriteRenderer->RenderPixelMesh(mesh, penPosition, scale);
+			}
+
+			penPosition.X += glyph->Advance * scale;
+			prevCodepoint = codepoint;
+		}
+
+		if (penPosition.X - position.X > maxLineWidth) maxLineWidth = penPosition.X - position.X;
+
+		return Vec2f(maxLineWidth, lineCount * lineHeight);
+	}
+
+	Uint32 GlyphAtlas::DecodeUTF8(const std::string& text, int& index)
+	{
+		constexpr Uint32 REPLACEMENT_CHARACTER = 0xFFFD;
+
+		const int length = text.size();
+		const Uint8 leadByte = (Uint8)text[index++];
+
+		if (leadByte < 0x80) return leadByte;
+
+		int continuationCount = 0;
+		Uint32 codepoint = 0;
+
+		if ((leadByte & 0xE0) == 0xC0)
+		{
+			continuationCount = 1;
+			codepoint = leadByte & 0x1F;
+		}
+		else if ((leadByte & 0xF0) == 0xE0)
+		{
+			continuationCount = 2;
+			codepoint = leadByte & 0x0F;
+		}
+		else if ((leadByte & 0xF8) == 0xF0)
+		{
+			continuationCount = 3;
+			codepoint = leadByte & 0x07;
+		}
+		else
+		{
+			return REPLACEMENT_CHARACTER;
+		}
+
+		for (int i = 0; i < continuationCount; i++)
+		{
+			if (index >= length || ((Uint8)text[index] & 0xC0) != 0x80)
+				return REPLACEMENT_CHARACTER; // Truncated sequence; the offending byte is decoded next
+
+			codepoint = (codepoint << 6) | ((Uint8)text[index++] & 0x3F);
+		}
+
+		return codepoint;
+	}
+
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <SDL_ttf.h>
+#include "Uncopyable.h"
+#include "PixMath.h"
+#include "SpriteMesh.h"
+#include "TargetTexture.h"
+#include "SpriteMeshRenderer2D.h"
+
+namespace pix
+{
+	// GlyphAtlas rasterizes the glyphs of a font once into an atlas TargetTexture and emits text as SpriteMesh quads.
+	// Dynamic text then only costs vertex generation instead of a new surface and texture per string, as with TextTexture.
+	//
+	// Technical note:
+	// Glyphs are rasterized in white, so the text color is applied through the vertex color.
+	// Glyphs missing from the atlas are added on demand. Adding glyphs renders into the atlas and then restores the previous
+	// render target, which still flushes pending SDL draw calls. Call AddGlyphs() with the expected character set before batching
+	// text (e.g. "0123456789" for score counters), so that no render target switch happens in the middle of a frame.
+	// Kerning between consecutive glyphs is applied if the font provides it.
+	// Like any TargetTexture, the atlas content can be lost when SDL resets its render targets (SDL_RENDER_TARGETS_RESET);
+	// call Reset() in that case to rasterize the glyphs again on demand.
+	//
+	// Usage:
+	// 1) spriteRenderer.BeginBatch(...);
+	// 2) glyphAtlas.RenderText(spriteRenderer, "Score: 100", Vec2f(8.0f, 8.0f));
+	// 3) spriteRenderer.RenderBatch(glyphAtlas.GetTexture(), nullptr);
+	//
+	// Philosophy:
+	// GlyphAtlas is the counterpart of TextTexture for text that changes frequently, such as scores, timers, and damage numbers.
+	// It does not take ownership of the TTF_Font, which must outlive the atlas.
+	// If the atlas is full, further glyphs are skipped and logged; choose the atlas size according to font size and character set.
+	class GlyphAtlas : private Uncopyable
+	{
+	public:
+
+		// renderBlended selects the rasterization mode as in TextTexture:
+		//   true  -> smooth, anti-aliased glyphs
+		//   false -> no anti-aliasing, sharp edges; suitable for pixel-art rendering
+		GlyphAtlas(TTF_Font* font, bool renderBlended = true, int atlasWidth = 512, int atlasHeight = 512);
+		~GlyphAtlas() = default;
+
+		// Rasterizes all glyphs of the UTF-8 text that are not in the atlas yet.
+		// Returns true if all glyphs are available afterwards, false otherwise.
+		bool AddGlyphs(const std::string& text);
+
+		// Clears the atlas. Glyphs are rasterized again on demand.
+		void Reset();
+
+		// Appends one quad per visible glyph of the UTF-8 text to the batch of spriteRenderer, in logical render-target space.
+		// position is the top-left corner of the text line; scale scales the glyph quads and advances.
+		// Newlines start a new line at position.X.
+		// Returns the width of the widest rendered line in logical render-target units.
+		float RenderText(SpriteMeshRenderer2D& spriteRenderer, const std::string& text, Vec2f position, float scale = 1.0f, SDL_Color color = { 255, 255, 255, 255 });
+
+		// Returns the size of the UTF-8 text in pixels at scale 1 without rendering it.
+		// Missing glyphs are added to the atlas.
+		Vec2f GetTextSize(const std::string& text);
+
+		// Returns the atlas texture to pass to SpriteMeshRenderer2D::RenderBatch()
+		TargetTexture& GetTexture();
+
+		// Returns the distance between two text lines in pixels at scale 1
+		int GetLineHeight() const;
+
+		int GetGlyphCount() const;
+
+		bool IsInitialized() const;
+
+	private:
+
+		static constexpr int GLYPH_PADDING = 1; // Empty pixels around each glyph to prevent bleeding with linear filtering
+
+		struct Glyph
+		{
+			SpriteMesh Mesh;   // Quad relative to the pen position, Y down; positions in pixels
+			int Advance = 0;
+			bool IsVisible = false;
+		};
+
+		// Returns the glyph for codepoint, rasterizing it if needed. Returns nullptr if the font does not provide the glyph.
+		// A glyph that did not fit into the atlas is kept as invisible glyph so that the text layout stays stable.
+		const Glyph* GetGlyph(Uint32 codepoint);
+
+		// Fills glyph with the metrics of codepoint and rasterizes it into the atlas.
+		// Returns false if the glyph could not be rasterized; glyph.IsVisible is false in that case.
+		bool RasterizeGlyph(Uint32 codepoint, Glyph& glyph);
+
+		// Lays out the UTF-8 text starting at position and returns its size.
+		// If spriteRenderer is not nullptr, the glyph quads are appended to its batch.
+		Vec2f LayoutText(SpriteMeshRenderer2D* spriteRenderer, const std::string& text, Vec2f position, float scale, SDL_Color color);
+
+		// Decodes the UTF-8 codepoint starting at index and advances index past it.
+		// Invalid sequences decode to U+FFFD.
+		static Uint32 DecodeUTF8(const std::string& text, int& index);
+
+		std::unordered_map<Uint32, Glyph> glyphs_;
+		TargetTexture atlasTexture_;
+		TTF_Font* font_ = nullptr;
+		int atlasWidth_ = 0;
+		int atlasHeight_ = 0;
+		int shelfX_ = 0;      // Packing cursor in the current shelf
+		int shelfY_ = 0;      // Top of the current shelf
+		int shelfHeight_ = 0; // Height of the tallest glyph in the current shelf
+		bool renderBlended_ = true;
+	};
+}
@@ -12,31 +12,57 @@ namespace pix
 
 	bool ImageTexture::Reload(const std::string& imagePath) 
 	{
-		SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND;
-		Uint8 r = 255, g = 255, b = 255, a = 255;
+		SDL_Texture* newTexture = IMG_LoadTexture(Renderer::Get().GetSDLRenderer(), imagePath.c_str());
 
-		// Cache blend state so it can be restored on the new texture
-		if (sdlTexture_)
+		if (!newTexture)
 		{
-			blendMode = GetBlendMode();
-			GetRGBAMod(r, g, b, a);
+			ErrorLogger::Get().LogSDLError("ImageTexture::Reload() - IMG_LoadTexture() failure");
+			return false;
 		}
 
-		SDL_Texture* newTexture = IMG_LoadTexture(Renderer::Get().GetSDLRenderer(), imagePath.c_str());
+		ReplaceSDLTexture(newTexture);
+
+		return true;
+	}
+
+	bool ImageTexture::Reload(SDL_Surface* imageSurface)
+	{
+		if (!imageSurface)
+		{
+			ErrorLogger::Get().LogError("ImageTexture::Reload() failure", "imageSurface is nullptr!");
+			return false;
+		}
+
+		SDL_Texture* newTexture = SDL_CreateTextureFromSurface(Renderer::Get().GetSDLRenderer(), imageSurface);
 
 		if (!newTexture)
 		{
-			ErrorLogger::Get().LogSDLError("ImageTexture::Reload() - IMG_LoadTexture() failure");
+			ErrorLogger::Get().LogSDLError("ImageTexture::Reload() - SDL_CreateTextureFromSurface() failure");
 			return false;
 		}
 
+		ReplaceSDLTexture(newTexture);
+
+		return true;
+	}
+
+	void ImageTexture::ReplaceSDLTexture(SDL_Texture* newTexture)
+	{
+		SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND;
+		Uint8 r = 255, g = 255, b = 255, a = 255;
+
+		// Cache blend state so it can be restored on the new texture
+		if (sdlTexture_)
+		{
+			blendMode = GetBlendMode();
+			GetRGBAMod(r, g, b, a);
+		}
+
 		DestroySDLTexture();
 		sdlTexture_ = newTexture;
 		
 		// Restore blend state
 		SetBlendMode(blendMode);
 		SetRGBAMod(r, g, b, a);
-
-		return true;
 	}
-}
\ No newline at end of file
+}
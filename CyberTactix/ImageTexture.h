@@ -2,6 +2,7 @@
 
 #include "Texture.h"
 #include <string>
+#include <SDL_surface.h>
 
 namespace pix
 {
@@ -20,5 +21,16 @@ namespace pix
 		// If called on an uninitialized texture, default SDL state is applied (SDL_BLENDMODE_BLEND, RGBA = 255, 255, 255, 255).
 		// Returns true if the texture is reloaded successfully, false otherwise.
 		bool Reload(const std::string& imagePath);
+
+		// Creates the texture from an already decoded image surface and preserves the previous blend state.
+		// The surface is not taken over; the caller remains responsible for freeing it.
+		// This is the upload step for images decoded off the render thread (see AsyncImageLoader).
+		// Returns true if the texture is reloaded successfully, false otherwise.
+		bool Reload(SDL_Surface* imageSurface);
+
+	private:
+
+		// Replaces sdlTexture_ with newTexture and restores the previous blend state on it
+		void ReplaceSDLTexture(SDL_Texture* newTexture);
 	};
-}
\ No newline at end of file
+}
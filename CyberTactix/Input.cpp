@@ -268,6 +268,19 @@ namespace pix
 
 	}
 
+	int GamepadInput::GetGamepadIndex(SDL_JoystickID joystickID) const
+	{
+		const int gamepadCount = gamepads_.size();
+
+		for (int i = 0; i < gamepadCount; i++)
+		{
+			if (gamepads_[i].IsInitialized && gamepads_[i].JoystickID == joystickID)
+				return i;
+		}
+
+		return -1;
+	}
+
 	float GamepadInput::GetAxisValue(int gamepadIndex, SDL_GameControllerAxis axis) const
 	{
 		if (!IsValidGamepadIndex(gamepadIndex)) return 0.0f;
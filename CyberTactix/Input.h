@@ -178,6 +178,10 @@ namespace pix
 
 		bool IsValidGamepadIndex(int gamepadIndex) const;
 
+		// Returns the gamepad index of the connected gamepad with the joystick instance ID, e.g. from SDL_ControllerButtonEvent::which.
+		// Returns -1 if no such gamepad is connected.
+		int GetGamepadIndex(SDL_JoystickID joystickID) const;
+
 		bool IsButtonDown(int gamepadIndex, SDL_GameControllerButton button) const;
 	
 		// Returns a normalized axis value. Sticks are in range [-1.0f,1.0f]. Triggers are in range [0.0f,1.0f].
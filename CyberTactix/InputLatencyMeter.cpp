@@ -0,0 +1,76 @@
+#include "InputLatencyMeter.h"
+#include <cmath>
+#include <SDL_timer.h>
+
+namespace pix
+{
+
+	void InputLatencyMeter::AddEvents(const std::vector<InputEvent>& events)
+	{
+		if (events.empty() || hasPendingEvents_) return; // Events are in order, so only the oldest one matters
+
+		pendingTimestamp_ = events.front().Timestamp;
+		hasPendingEvents_ = true;
+	}
+
+	void InputLatencyMeter::BeginRender()
+	{
+		hasRenderedEvents_ = hasPendingEvents_;
+		renderedTimestamp_ = pendingTimestamp_;
+
+		hasPendingEvents_ = false;
+	}
+
+	void InputLatencyMeter::EndPresent()
+	{
+		if (!hasRenderedEvents_) return;
+
+		hasRenderedEvents_ = false;
+
+		// Unsigned difference, correct across the 49-day wrap of 32-bit SDL ticks
+		lastLatency_ = (Uint32)(SDL_GetTicks() - renderedTimestamp_);
+
+		if (lastLatency_ > latencyMax_) latencyMax_ = lastLatency_;
+
+		sampleCount_++;
+
+		const double delta = lastLatency_ - latencyMean_;
+		latencyMean_ += delta / sampleCount_;
+		latencySquaredDeviationSum_ += delta * (lastLatency_ - latencyMean_);
+	}
+
+	void InputLatencyMeter::ResetStatistics()
+	{
+		lastLatency_ = 0.0;
+		latencyMax_ = 0.0;
+		sampleCount_ = 0;
+		latencyMean_ = 0.0;
+		latencySquaredDeviationSum_ = 0.0;
+	}
+
+	double InputLatencyMeter::GetLastLatency() const
+	{
+		return lastLatency_;
+	}
+
+	double InputLatencyMeter::GetLatencyMean() const
+	{
+		return latencyMean_;
+	}
+
+	double InputLatencyMeter::GetLatencyStandardDeviation() const
+	{
+		return sampleCount_ > 1 ? std::sqrt(latencySquaredDeviationSum_ / (sampleCount_ - 1)) : 0.0;
+	}
+
+	double InputLatencyMeter::GetLatencyMax() const
+	{
+		return latencyMax_;
+	}
+
+	int InputLatencyMeter::GetSampleCount() const
+	{
+		return sampleCount_;
+	}
+
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <vector>
+#include <SDL_stdinc.h>
+#include "DeviceInput.h"
+
+namespace pix
+{
+	// InputLatencyMeter measures the time from an input event to the present of the first frame that reflects it.
+	//
+	// Technical note:
+	// Each frame with input events yields one sample: the time from its oldest event to the return of the present call,
+	// which is the worst-case latency of that frame. Both ends are read on the SDL_GetTicks() clock, as SDL event timestamps
+	// have millisecond resolution; at common refresh rates this is still a fraction of a frame.
+	// The measurement ends when SwapBuffers() returns, not when the display scans the image out, so display latency is not included.
+	// Requires event capture (LaunchConfigData::IsInputEventCapture), as the events come from DeviceInput.
+	//
+	// Usage:
+	// GameLoop drives the meter: AddEvents() after each DeviceInput::Update(), BeginRender() when the updated state is rendered,
+	// EndPresent() after SwapBuffers(). In pipelined mode, events reach the screen one frame later, which the meter includes.
+	// Compare the statistics across vsync, frame limiter, and scheduler settings to minimize input lag.
+	class InputLatencyMeter
+	{
+	public:
+
+		InputLatencyMeter() = default;
+		~InputLatencyMeter() = default;
+
+		// Adds the events of an update, which are reflected in the next frame passed to BeginRender()
+		void AddEvents(const std::vector<InputEvent>& events);
+
+		// Marks the events added so far as reflected in the frame that is rendered now
+		void BeginRender();
+
+		// Measures the latency of the events of the rendered frame. Call right after the frame was presented.
+		void EndPresent();
+
+		// Clears the latency statistics
+		void ResetStatistics();
+
+		// Returns the latency of the last measured frame in milliseconds, or 0 if no frame was measured
+		double GetLastLatency() const;
+
+		// Returns the mean latency in milliseconds
+		double GetLatencyMean() const;
+
+		// Returns the standard deviation of the latency in milliseconds
+		double GetLatencyStandardDeviation() const;
+
+		// Returns the maximum latency in milliseconds
+		double GetLatencyMax() const;
+
+		// Returns the number of frames with input events covered by the statistics
+		int GetSampleCount() const;
+
+	private:
+
+		bool hasPendingEvents_ = false;
+		bool hasRenderedEvents_ = false;
+		Uint32 pendingTimestamp_ = 0;  // Oldest event timestamp not rendered yet
+		Uint32 renderedTimestamp_ = 0; // Oldest event timestamp of the frame being rendered
+
+		double lastLatency_ = 0.0;
+		double latencyMax_ = 0.0;
+
+		// Welford's online algorithm, as in FrameLimiter
+		int    sampleCount_ = 0;
+		double latencyMean_ = 0.0;
+		double latencySquaredDeviationSum_ = 0.0;
+	};
+}
@@ -1,5 +1,6 @@
 #include "InputPumps.h"
 #include "PixMath.h"
+#include "DeviceInput.h"
 
 namespace pix
 {
@@ -16,7 +17,12 @@ namespace pix
 
 		float KeyboardInputPump::GetSourceState() const
 		{
-			return KeyboardInput::Get().IsKeyDown(sourceKey_) ? 1.0f : 0.0f;
+			return GetSourceState(DeviceInput::Get().GetState());
+		}
+
+		float KeyboardInputPump::GetSourceState(const DeviceState& state) const
+		{
+			return state.IsKeyDown(sourceKey_) ? 1.0f : 0.0f;
 		}
 
 		SDL_Scancode KeyboardInputPump::GetSourceKey() const 
@@ -38,7 +44,12 @@ namespace pix
 
 		float MouseButtonInputPump::GetSourceState() const
 		{
-			return MouseInput::Get().IsButtonDown(sourceButton_) ? 1.0f : 0.0f;
+			return GetSourceState(DeviceInput::Get().GetState());
+		}
+
+		float MouseButtonInputPump::GetSourceState(const DeviceState& state) const
+		{
+			return state.IsMouseButtonDown(sourceButton_) ? 1.0f : 0.0f;
 		}
 
 		MouseInput::Button MouseButtonInputPump::GetSourceButton() const
@@ -79,11 +90,16 @@ namespace pix
 		}
 
 		float GamepadInputPump::GetSourceState() const 
+		{
+			return GetSourceState(DeviceInput::Get().GetState());
+		}
+
+		float GamepadInputPump::GetSourceState(const DeviceState& state) const
 		{
 			if (sourceButton_ != SDL_CONTROLLER_BUTTON_INVALID)
-				return GamepadInput::Get().IsButtonDown(sourceGamepadIndex_, sourceButton_) ? 1.0f : 0.0f;
+				return state.IsGamepadButtonDown(sourceGamepadIndex_, sourceButton_) ? 1.0f : 0.0f;
 			else if (sourceAxis_ != SDL_CONTROLLER_AXIS_INVALID)
-				return GamepadInput::Get().GetAxisValue(sourceGamepadIndex_, sourceAxis_);
+				return state.GetGamepadAxisValue(sourceGamepadIndex_, sourceAxis_);
 
 			return 0.0f;
 		}
@@ -127,6 +143,11 @@ namespace pix
 			return sourceState_;
 		}
 
+		float VirtualInputPump::GetSourceState(const DeviceState&) const
+		{
+			return sourceState_;
+		}
+
 		int VirtualInputPump::GetSourceID() const
 		{
 			return sourceID_;
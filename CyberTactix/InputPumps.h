@@ -3,13 +3,15 @@
 #include "AbstractInputPump.h"
 #include "Input.h"
 
-// These pump classes internally query KeyboardInput, MouseInput, and GamepadInput
+// These pump classes read the per-update DeviceState snapshot of DeviceInput, which is captured from KeyboardInput, MouseInput, and GamepadInput
+// The pump classes are final, so calls through the concrete type, such as in ObjectInput's typed pump loops, need no virtual dispatch
 
 namespace pix
 {
+	struct DeviceState;
 
 	// KeyboardInputPump has a physical keyboard key as its input source. It connects it to a virtual axis.
-	class KeyboardInputPump : public AbstractInputPump
+	class KeyboardInputPump final : public AbstractInputPump
 	{
 	public:
 
@@ -22,6 +24,9 @@ namespace pix
 		// Returns 1.0f if key is pressed, 0.0f otherwise
 		float GetSourceState() const override;
 
+		// Like GetSourceState(), but reads the given state, so batched pump loops fetch the DeviceInput state once
+		float GetSourceState(const DeviceState& state) const;
+
 		SDL_Scancode GetSourceKey() const;
 
 
@@ -35,7 +40,7 @@ namespace pix
 
 	// MouseButtonInputPump has a physical mouse button as its input source. It connects it to a virtual axis.
 	// This pump only handles button state; position/wheel are handled elsewhere.
-	class MouseButtonInputPump : public AbstractInputPump
+	class MouseButtonInputPump final : public AbstractInputPump
 	{
 	public:
 
@@ -48,6 +53,9 @@ namespace pix
 		// Returns 1.0f if button is pressed, 0.0f otherwise
 		float GetSourceState() const override;
 
+		// Like GetSourceState(), but reads the given state
+		float GetSourceState(const DeviceState& state) const;
+
 		MouseInput::Button GetSourceButton() const;
 
 	private:
@@ -58,7 +66,7 @@ namespace pix
 
 
 	// GamepadInputPump has a physical gamepad button or a physical gamepad axis as its input source. It connects it to a virtual axis.
-	class GamepadInputPump : public AbstractInputPump
+	class GamepadInputPump final : public AbstractInputPump
 	{
 	public:
 
@@ -78,6 +86,9 @@ namespace pix
 		// For button: returns 1.0f if pressed, 0.0f otherwise
 		float GetSourceState() const override;
 
+		// Like GetSourceState(), but reads the given state
+		float GetSourceState(const DeviceState& state) const;
+
 		int GetSourceGamepadIndex() const;
 		SDL_GameControllerButton GetSourceButton() const;
 		SDL_GameControllerAxis  GetSourceAxis() const;
@@ -95,7 +106,7 @@ namespace pix
     // It is driven directly by user code and connects that source to a virtual axis.
     // The source ID serves to differentiate between input sources, and its validity depends on the owner.
     // A typical use case is AI-driven input.
-	class VirtualInputPump : public AbstractInputPump
+	class VirtualInputPump final : public AbstractInputPump
 	{
 	public:
 
@@ -113,6 +124,9 @@ namespace pix
 		// Returns the value set by SetSourceState(), in range [-1.0f, 1.0f]
 		float GetSourceState() const override;
 
+		// Ignores state; exists so that batched pump loops treat all pump types alike
+		float GetSourceState(const DeviceState& state) const;
+
 		int GetSourceID() const;
 
 	private:
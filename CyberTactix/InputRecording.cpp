@@ -0,0 +1,398 @@
+#include "InputRecording.h"
+#include <SDL_stdinc.h>
+#include "ErrorLogger.h"
+
+namespace pix
+{
+
+	namespace
+	{
+		constexpr char FILE_MAGIC[8] = { 'P', 'I', 'X', 'I', 'N', 'P', 'U', 'T' };
+		constexpr Uint32 FILE_VERSION = 1;
+		constexpr int MAX_BLOCK_STATE_COUNT = 65536; // Guards replay allocations against corrupted counts
+
+		// Writes value as LEB128 varint: 7 bits per byte, small values take one byte
+		void WriteVarint(std::vector<Uint8>& bytes, Uint32 value)
+		{
+			while (value >= 0x80)
+			{
+				bytes.push_back((Uint8)(value | 0x80));
+				value >>= 7;
+			}
+
+			bytes.push_back((Uint8)value);
+		}
+
+		bool ReadVarint(const std::vector<Uint8>& bytes, size_t& position, Uint32& value)
+		{
+			value = 0;
+
+			for (int shift = 0; shift < 32; shift += 7)
+			{
+				if (position >= bytes.size()) return false;
+
+				const Uint8 byte = bytes[position++];
+				value |= (Uint32)(byte & 0x7F) << shift;
+
+				if ((byte & 0x80) == 0) return true;
+			}
+
+			return false;
+		}
+
+		// Writes the runs of bytes in which data differs from reference as (skip, length, bytes) triples, terminated by (0, 0).
+		// skip counts the unchanged bytes since the end of the previous run. reference is updated to data.
+		void WriteDelta(std::vector<Uint8>& bytes, Uint8* reference, const Uint8* data, int size)
+		{
+			constexpr int MAX_GAP = 4; // Shorter gaps of unchanged bytes are cheaper to store inside a run than to start a new run
+
+			int runEnd = 0;
+			int i = 0;
+
+			while (i < size)
+			{
+				if (reference[i] == data[i])
+				{
+					i++;
+					continue;
+				}
+
+				const int runStart = i;
+				int lastChanged = i;
+
+				while (i < size && i - lastChanged <= MAX_GAP)
+				{
+					if (reference[i] != data[i]) lastChanged = i;
+					i++;
+				}
+
+				const int runLength = lastChanged + 1 - runStart;
+
+				WriteVarint(bytes, runStart - runEnd);
+				WriteVarint(bytes, runLength);
+				bytes.insert(bytes.end(), data + runStart, data + runStart + runLength);
+
+				SDL_memcpy(reference + runStart, data + runStart, runLength);
+
+				runEnd = runStart + runLength;
+				i = runEnd;
+			}
+
+			WriteVarint(bytes, 0);
+			WriteVarint(bytes, 0);
+		}
+
+		// Applies the runs written by WriteDelta() to data. Returns false if the runs are truncated or exceed size.
+		bool ReadDelta(const std::vector<Uint8>& bytes, size_t& position, Uint8* data, int size)
+		{
+			Uint32 offset = 0;
+
+			while (true)
+			{
+				Uint32 skip = 0, length = 0;
+
+				if (!ReadVarint(bytes, position, skip) || !ReadVarint(bytes, position, length)) return false;
+
+				if (length == 0) return skip == 0;
+
+				if (skip > size - offset || length > size - offset - skip || length > bytes.size() - position) return false;
+
+				offset += skip;
+
+				SDL_memcpy(data + offset, &bytes[position], length);
+
+				position += length;
+				offset += length;
+			}
+		}
+	}
+
+
+
+	InputRecorder::~InputRecorder()
+	{
+		Stop();
+	}
+
+	bool InputRecorder::Start(const std::string& outputPath)
+	{
+		Stop();
+
+		file_ = SDL_RWFromFile(outputPath.c_str(), "wb");
+
+		if (!file_)
+		{
+			ErrorLogger::Get().LogSDLError("InputRecorder::Start() - SDL_RWFromFile() failure");
+			return false;
+		}
+
+		buffer_.clear();
+		blockBuffer_.clear();
+		prevBlocks_.clear();
+		SDL_memset(prevDeviceState_, 0, sizeof(prevDeviceState_));
+		blockCount_ = 0;
+		updateCount_ = 0;
+		isUpdateOpen_ = false;
+
+		buffer_.insert(buffer_.end(), FILE_MAGIC, FILE_MAGIC + sizeof(FILE_MAGIC));
+		WriteVarint(buffer_, FILE_VERSION);
+		WriteVarint(buffer_, sizeof(DeviceState));
+
+		return true;
+	}
+
+	void InputRecorder::Stop()
+	{
+		if (!file_) return;
+
+		if (isUpdateOpen_) EndUpdate();
+
+		if (file_ && Flush() && SDL_RWclose(file_) != 0)
+			ErrorLogger::Get().LogSDLError("InputRecorder::Stop() - SDL_RWclose() failure");
+
+		file_ = nullptr;
+	}
+
+	void InputRecorder::RecordUpdate(const DeviceState& deviceState)
+	{
+		if (!file_) return;
+
+		if (isUpdateOpen_) EndUpdate();
+
+		if (!file_) return; // EndUpdate() stops the recording on write errors
+
+		Uint8 deviceStateBytes[sizeof(DeviceState)];
+		SDL_memcpy(deviceStateBytes, &deviceState, sizeof(DeviceState));
+
+		WriteDelta(buffer_, prevDeviceState_, deviceStateBytes, sizeof(DeviceState));
+
+		blockBuffer_.clear();
+		blockCount_ = 0;
+		isUpdateOpen_ = true;
+		updateCount_++;
+	}
+
+	void InputRecorder::RecordVirtualSourceStates(const float* sourceStates, int count)
+	{
+		if (!isUpdateOpen_) return;
+
+		if (!sourceStates || count < 0) count = 0;
+
+		if (count > MAX_BLOCK_STATE_COUNT)
+		{
+			ErrorLogger::Get().LogError("InputRecorder::RecordVirtualSourceStates() failure", "Too many states in one block, the rest is dropped!");
+			count = MAX_BLOCK_STATE_COUNT;
+		}
+
+		if (blockCount_ == (int)prevBlocks_.size())
+			prevBlocks_.emplace_back();
+
+		std::vector<float>& prevBlock = prevBlocks_[blockCount_];
+
+		// A block that changed its size is encoded against zero states
+		if ((int)prevBlock.size() != count)
+			prevBlock.assign(count, 0.0f);
+
+		WriteVarint(blockBuffer_, count);
+		WriteDelta(blockBuffer_, (Uint8*)prevBlock.data(), (const Uint8*)sourceStates, count * sizeof(float));
+
+		blockCount_++;
+	}
+
+	int InputRecorder::GetUpdateCount() const
+	{
+		return updateCount_;
+	}
+
+	bool InputRecorder::IsRecording() const
+	{
+		return file_ != nullptr;
+	}
+
+
+
+	void InputRecorder::EndUpdate()
+	{
+		WriteVarint(buffer_, blockCount_);
+		buffer_.insert(buffer_.end(), blockBuffer_.begin(), blockBuffer_.end());
+
+		isUpdateOpen_ = false;
+
+		if (buffer_.size() >= FLUSH_SIZE)
+			Flush();
+	}
+
+	bool InputRecorder::Flush()
+	{
+		const size_t size = buffer_.size();
+
+		if (size > 0 && SDL_RWwrite(file_, buffer_.data(), 1, size) != size)
+		{
+			ErrorLogger::Get().LogSDLError("InputRecorder::Flush() - SDL_RWwrite() failure");
+
+			SDL_RWclose(file_);
+			file_ = nullptr;
+			buffer_.clear();
+
+			return false;
+		}
+
+		buffer_.clear();
+
+		return true;
+	}
+
+
+
+	bool InputReplay::Load(const std::string& inputPath)
+	{
+		data_.clear();
+		dataStart_ = 0;
+		Rewind();
+
+		SDL_RWops* file = SDL_RWFromFile(inputPath.c_str(), "rb");
+
+		if (!file)
+		{
+			ErrorLogger::Get().LogSDLError("InputReplay::Load() - SDL_RWFromFile() failure");
+			return false;
+		}
+
+		const Sint64 size = SDL_RWsize(file);
+
+		if (size > 0)
+		{
+			data_.resize(size);
+
+			if (SDL_RWread(file, data_.data(), 1, size) != (size_t)size)
+			{
+				ErrorLogger::Get().LogSDLError("InputReplay::Load() - SDL_RWread() failure");
+				data_.clear();
+			}
+		}
+
+		SDL_RWclose(file);
+
+		Uint32 version = 0, deviceStateSize = 0;
+		size_t position = sizeof(FILE_MAGIC);
+
+		if (data_.size() < sizeof(FILE_MAGIC) || SDL_memcmp(data_.data(), FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 ||
+			!ReadVarint(data_, position, version) || !ReadVarint(data_, position, deviceStateSize))
+		{
+			ErrorLogger::Get().LogError("InputReplay::Load() failure", inputPath + " is not an input recording!");
+			data_.clear();
+			return false;
+		}
+
+		if (version != FILE_VERSION || deviceStateSize != sizeof(DeviceState))
+		{
+			ErrorLogger::Get().LogError("InputReplay::Load() failure", inputPath + " was recorded with an incompatible build!");
+			data_.clear();
+			return false;
+		}
+
+		dataStart_ = position;
+		Rewind();
+
+		return true;
+	}
+
+	bool InputReplay::ReadUpdate()
+	{
+		if (isFinished_) return false;
+
+		blockCount_ = 0;
+
+		if (position_ >= data_.size())
+		{
+			isFinished_ = true;
+			return false;
+		}
+
+		Uint32 blockCount = 0;
+		bool isValid = ReadDelta(data_, position_, deviceStateBytes_, sizeof(DeviceState)) && ReadVarint(data_, position_, blockCount);
+
+		for (Uint32 i = 0; isValid && i < blockCount; i++)
+		{
+			Uint32 count = 0;
+			isValid = ReadVarint(data_, position_, count) && count <= MAX_BLOCK_STATE_COUNT;
+
+			if (!isValid) break;
+
+			if (i == blocks_.size())
+				blocks_.emplace_back();
+
+			std::vector<float>& block = blocks_[i];
+
+			if (block.size() != count)
+				block.assign(count, 0.0f);
+
+			isValid = ReadDelta(data_, position_, (Uint8*)block.data(), count * sizeof(float));
+		}
+
+		if (!isValid)
+		{
+			ErrorLogger::Get().LogError("InputReplay::ReadUpdate() failure", "The record of update " + std::to_string(updateCount_) + " is corrupted!");
+			isFinished_ = true;
+			return false;
+		}
+
+		SDL_memcpy(&deviceState_, deviceStateBytes_, sizeof(DeviceState));
+
+		blockCount_ = blockCount;
+		updateCount_++;
+
+		return true;
+	}
+
+	void InputReplay::Rewind()
+	{
+		blocks_.clear();
+		SDL_memset(deviceStateBytes_, 0, sizeof(deviceStateBytes_));
+		deviceState_ = DeviceState();
+		position_ = dataStart_;
+		blockCount_ = 0;
+		updateCount_ = 0;
+		isFinished_ = data_.empty();
+	}
+
+	const DeviceState& InputReplay::GetDeviceState() const
+	{
+		return deviceState_;
+	}
+
+	const float* InputReplay::GetVirtualSourceStates(int blockIndex) const
+	{
+		if (blockIndex < 0 || blockIndex >= blockCount_) return nullptr;
+
+		return blocks_[blockIndex].data();
+	}
+
+	int InputReplay::GetVirtualSourceStateCount(int blockIndex) const
+	{
+		if (blockIndex < 0 || blockIndex >= blockCount_) return 0;
+
+		return blocks_[blockIndex].size();
+	}
+
+	int InputReplay::GetVirtualSourceBlockCount() const
+	{
+		return blockCount_;
+	}
+
+	int InputReplay::GetUpdateCount() const
+	{
+		return updateCount_;
+	}
+
+	bool InputReplay::IsFinished() const
+	{
+		return isFinished_;
+	}
+
+	bool InputReplay::IsLoaded() const
+	{
+		return !data_.empty();
+	}
+
+}
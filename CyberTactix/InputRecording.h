@@ -0,0 +1,142 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <SDL_rwops.h>
+#include "Uncopyable.h"
+#include "DeviceInput.h"
+
+namespace pix
+{
+	// InputRecorder writes the input of every update to a compact binary stream, which InputReplay plays back.
+	//
+	// Technical note:
+	// One record is written per update: the DeviceState seen by that update, followed by any blocks of virtual source states
+	// that user code adds during the update (e.g. ObjectInput::GetVirtualSourceStates() of AI-driven objects).
+	// Each record is delta-encoded against the previous one: only runs of changed bytes are stored, so an update without
+	// input changes costs a few bytes instead of a full DeviceState.
+	// Records are buffered in memory and written to the file in chunks; Stop() writes the rest and closes the file.
+	// The stream stores DeviceState as raw bytes, so recordings are only portable between builds with the same DeviceState layout
+	// and byte order. The header stores the layout size, and InputReplay rejects mismatching recordings.
+	//
+	// Usage:
+	// 1) recorder.Start(prefPath + "Session.pixinput");
+	// 2) gameLoop.SetInputRecorder(&recorder); // GameLoop calls RecordUpdate() before every Update()
+	// 3) In Update(): count = objectInput.GetVirtualSourceStates(states, MAX_COUNT); recorder.RecordVirtualSourceStates(states, count);
+	// 4) recorder.Stop();
+	//
+	// Philosophy:
+	// Input is keyed by update, not by time: a replay reproduces the same sequence of updates regardless of frame rate.
+	// For headless regression runs at maximum speed, also set GameLoop::SetReplayUpdatesPerFrame(), so that neither the update loop
+	// scheduler nor the frame limiter paces the replay to real time.
+	// Input that is not part of DeviceState, such as mouse wheel events read directly from MouseInput, is not recorded.
+	class InputRecorder : private Uncopyable
+	{
+	public:
+
+		InputRecorder() = default;
+		~InputRecorder();
+
+		// Creates or truncates the output file and starts a new recording. A running recording is stopped first.
+		// Returns true on success, false otherwise.
+		bool Start(const std::string& outputPath);
+
+		// Writes the buffered records and closes the file
+		void Stop();
+
+		// Begins the record of the next update with its device state. Called by GameLoop before every Update().
+		void RecordUpdate(const DeviceState& deviceState);
+
+		// Adds a block of virtual source states to the record of the current update.
+		// InputReplay returns the blocks by index, in the order they were added during the update.
+		void RecordVirtualSourceStates(const float* sourceStates, int count);
+
+		// Returns the number of updates recorded since Start()
+		int GetUpdateCount() const;
+
+		bool IsRecording() const;
+
+	private:
+
+		static constexpr int FLUSH_SIZE = 64 * 1024; // Buffered bytes that trigger a file write
+
+		// Appends the virtual source state blocks of the current update to the buffer
+		void EndUpdate();
+
+		// Writes the buffer to the file. Returns false on a write error, which stops the recording.
+		bool Flush();
+
+		std::vector<Uint8> buffer_;
+		std::vector<Uint8> blockBuffer_;                    // Encoded virtual source state blocks of the current update
+		std::vector<std::vector<float>> prevBlocks_;        // Reference states for delta-encoding the blocks
+		Uint8 prevDeviceState_[sizeof(DeviceState)] = {};  // Reference bytes for delta-encoding the device state
+		SDL_RWops* file_ = nullptr;
+		int blockCount_ = 0;
+		int updateCount_ = 0;
+		bool isUpdateOpen_ = false;
+	};
+
+
+	// InputReplay plays back a recording of InputRecorder one update at a time.
+	//
+	// Technical note:
+	// The whole recording is loaded into memory by Load(), so replaying never touches the file system.
+	// ReadUpdate() decodes the record of the next update; afterwards GetDeviceState() and GetVirtualSourceStates() return its content.
+	//
+	// Usage:
+	// 1) replay.Load(prefPath + "Session.pixinput");
+	// 2) gameLoop.SetInputReplay(&replay); // GameLoop feeds GetDeviceState() to DeviceInput before every Update()
+	// 3) In Update(): objectInput.SetVirtualSourceStates(replay.GetVirtualSourceStates(0), replay.GetVirtualSourceStateCount(0));
+	//
+	// Philosophy:
+	// Replays are only as deterministic as the simulation: game code must not depend on wall-clock time or unseeded randomness.
+	class InputReplay : private Uncopyable
+	{
+	public:
+
+		InputReplay() = default;
+		~InputReplay() = default;
+
+		// Loads a recording. Returns true on success, false otherwise.
+		bool Load(const std::string& inputPath);
+
+		// Decodes the record of the next update.
+		// Returns false if the replay is finished or not loaded; a corrupted record is logged and finishes the replay.
+		bool ReadUpdate();
+
+		// Restarts the replay from the first update
+		void Rewind();
+
+		// Returns the device state of the current update
+		const DeviceState& GetDeviceState() const;
+
+		// Returns the block of virtual source states with the given index in the current update, or nullptr if there is none
+		const float* GetVirtualSourceStates(int blockIndex) const;
+
+		// Returns the number of states in the block, or 0 if there is no such block in the current update
+		int GetVirtualSourceStateCount(int blockIndex) const;
+
+		// Returns the number of virtual source state blocks in the current update
+		int GetVirtualSourceBlockCount() const;
+
+		// Returns the number of updates read since Load() or Rewind()
+		int GetUpdateCount() const;
+
+		bool IsFinished() const;
+
+		bool IsLoaded() const;
+
+	private:
+
+		std::vector<Uint8> data_;
+		std::vector<std::vector<float>> blocks_;
+		Uint8 deviceStateBytes_[sizeof(DeviceState)] = {};
+		DeviceState deviceState_;
+		size_t dataStart_ = 0; // Position of the first record after the header
+		size_t position_ = 0;
+		int blockCount_ = 0;
+		int updateCount_ = 0;
+		bool isFinished_ = true;
+	};
+
+}
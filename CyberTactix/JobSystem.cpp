@@ -0,0 +1,469 @@
+#include "JobSystem.h"
+#include <SDL_cpuinfo.h>
+#include "ErrorLogger.h"
+#include "PixMath.h"
+
+namespace pix
+{
+
+	namespace
+	{
+		// Identifies the worker threads of a JobSystem; threads outside any pool use deque 0
+		thread_local const JobSystem* currentJobSystem = nullptr;
+		thread_local int currentQueueIndex = 0;
+	}
+
+	JobSystem::JobSystem(int workerCount)
+	{
+		if (workerCount < 0)
+			workerCount = SDL_GetCPUCount() - 1;
+
+		workerCount = GetClamped(workerCount, 0, 64);
+
+		SDL_AtomicSet(&queuedTaskCount_, 0);
+		SDL_AtomicSet(&startedWorkerCount_, 0);
+
+		wakeMutex_ = SDL_CreateMutex();
+		wakeCondition_ = SDL_CreateCond();
+		mainThreadMutex_ = SDL_CreateMutex();
+
+		if (!wakeMutex_ || !wakeCondition_ || !mainThreadMutex_)
+		{
+			ErrorLogger::Get().LogSDLError("JobSystem::JobSystem() - SDL_CreateMutex()/SDL_CreateCond() failure");
+			return;
+		}
+
+		// All deques exist before the first worker starts stealing
+		for (int i = 0; i <= workerCount; i++)
+		{
+			std::unique_ptr<TaskQueue> taskQueue(new TaskQueue());
+			taskQueue->Mutex = SDL_CreateMutex();
+
+			if (!taskQueue->Mutex)
+			{
+				ErrorLogger::Get().LogSDLError("JobSystem::JobSystem() - SDL_CreateMutex() failure");
+				break;
+			}
+
+			taskQueues_.push_back(std::move(taskQueue));
+		}
+
+		if (taskQueues_.empty()) return;
+
+		workerCount = taskQueues_.size() - 1;
+
+		for (int i = 0; i < workerCount; i++)
+		{
+			SDL_Thread* worker = SDL_CreateThread(RunWorker, "PixJobWorker", this);
+
+			if (!worker)
+			{
+				ErrorLogger::Get().LogSDLError("JobSystem::JobSystem() - SDL_CreateThread() failure");
+				break;
+			}
+
+			workers_.push_back(worker);
+		}
+	}
+
+	JobSystem::~JobSystem()
+	{
+		if (wakeMutex_)
+		{
+			SDL_LockMutex(wakeMutex_);
+			isStopping_ = true;
+			SDL_CondBroadcast(wakeCondition_);
+			SDL_UnlockMutex(wakeMutex_);
+		}
+
+		const int workerCount = workers_.size();
+
+		for (int i = 0; i < workerCount; i++)
+			SDL_WaitThread(workers_[i], nullptr);
+
+		for (const std::unique_ptr<TaskQueue>& taskQueue : taskQueues_)
+			SDL_DestroyMutex(taskQueue->Mutex);
+
+		SDL_DestroyMutex(mainThreadMutex_);
+		SDL_DestroyCond(wakeCondition_);
+		SDL_DestroyMutex(wakeMutex_);
+	}
+
+	void JobSystem::ParallelFor(int count, int batchSize, JobFunction jobFunction, void* userData)
+	{
+		if (count <= 0 || !jobFunction) return;
+
+		if (batchSize < 1) batchSize = 1;
+
+		// Without workers or with a single batch there is nothing to distribute
+		if (workers_.empty() || count <= batchSize)
+		{
+			jobFunction(0, count, userData);
+			return;
+		}
+
+		const int batchCount = (count + batchSize - 1) / batchSize;
+
+		SDL_atomic_t remainingCount;
+		SDL_AtomicSet(&remainingCount, batchCount);
+
+		TaskQueue& taskQueue = *taskQueues_[GetQueueIndex()];
+
+		SDL_LockMutex(taskQueue.Mutex);
+
+		// The owner pops from the back, thieves take from the front; push in reverse order so that both start at the range start
+		for (int i = batchCount - 1; i >= 0; i--)
+		{
+			Task task;
+			task.Function = jobFunction;
+			task.UserData = userData;
+			task.Begin = i * batchSize;
+			task.End = task.Begin + batchSize < count ? task.Begin + batchSize : count;
+			task.RemainingCount = &remainingCount;
+
+			taskQueue.Tasks.push_back(task);
+		}
+
+		SDL_UnlockMutex(taskQueue.Mutex);
+
+		NotifyTasksQueued(batchCount);
+
+		WaitFor(&remainingCount);
+	}
+
+	bool JobSystem::Run(TaskGraph& taskGraph)
+	{
+		if (!taskGraph.Validate()) return false;
+
+		std::vector<TaskGraph::Node>& nodes = taskGraph.nodes_;
+		const int nodeCount = nodes.size();
+
+		if (nodeCount == 0) return true;
+
+		// Without workers, the topological order from the validation is a valid sequential schedule
+		if (workers_.empty())
+		{
+			for (int nodeIndex : taskGraph.sortedIndices_)
+			{
+				if (nodes[nodeIndex].Function)
+					nodes[nodeIndex].Function(nodes[nodeIndex].UserData);
+			}
+
+			return true;
+		}
+
+		for (TaskGraph::Node& node : nodes)
+			SDL_AtomicSet(&node.UnresolvedCount, node.DependencyCount);
+
+		SDL_atomic_t remainingCount;
+		SDL_AtomicSet(&remainingCount, nodeCount);
+
+		TaskQueue& taskQueue = *taskQueues_[GetQueueIndex()];
+
+		SDL_LockMutex(taskQueue.Mutex);
+
+		for (int i = 0; i < taskGraph.rootCount_; i++)
+		{
+			Task task;
+			task.Graph = &taskGraph;
+			task.NodeIndex = taskGraph.sortedIndices_[i];
+			task.RemainingCount = &remainingCount;
+
+			taskQueue.Tasks.push_back(task);
+		}
+
+		SDL_UnlockMutex(taskQueue.Mutex);
+
+		NotifyTasksQueued(taskGraph.rootCount_);
+
+		WaitFor(&remainingCount);
+
+		return true;
+	}
+
+	void JobSystem::RunOnMainThread(TaskFunction taskFunction, void* userData)
+	{
+		if (!taskFunction) return;
+
+		if (!mainThreadMutex_)
+		{
+			ErrorLogger::Get().LogError("JobSystem::RunOnMainThread() failure", "JobSystem is not initialized!");
+			return;
+		}
+
+		SDL_LockMutex(mainThreadMutex_);
+		mainThreadTasks_.push_back(MainThreadTask{ taskFunction, userData });
+		SDL_UnlockMutex(mainThreadMutex_);
+	}
+
+	int JobSystem::ProcessMainThreadTasks()
+	{
+		if (!mainThreadMutex_) return 0;
+
+		SDL_LockMutex(mainThreadMutex_);
+		processedMainThreadTasks_.swap(mainThreadTasks_);
+		SDL_UnlockMutex(mainThreadMutex_);
+
+		const int taskCount = processedMainThreadTasks_.size();
+
+		for (int i = 0; i < taskCount; i++)
+			processedMainThreadTasks_[i].Function(processedMainThreadTasks_[i].UserData);
+
+		processedMainThreadTasks_.clear(); // Keeps the capacity for the next frame
+
+		return taskCount;
+	}
+
+	int JobSystem::GetWorkerCount() const
+	{
+		return workers_.size();
+	}
+
+
+
+	int SDLCALL JobSystem::RunWorker(void* jobSystem)
+	{
+		JobSystem* self = static_cast<JobSystem*>(jobSystem);
+
+		ErrorLogger::Get().InstallThreadCrashHandler();
+
+		// Deque 0 belongs to the threads outside the pool
+		const int queueIndex = SDL_AtomicAdd(&self->startedWorkerCount_, 1) + 1;
+
+		currentJobSystem = self;
+		currentQueueIndex = queueIndex;
+
+		self->RunWorkerLoop(queueIndex);
+		return 0;
+	}
+
+	void JobSystem::RunWorkerLoop(int queueIndex)
+	{
+		while (true)
+		{
+			if (RunNextTask(queueIndex)) continue;
+
+			SDL_LockMutex(wakeMutex_);
+
+			while (SDL_AtomicGet(&queuedTaskCount_) == 0 && !isStopping_)
+				SDL_CondWait(wakeCondition_, wakeMutex_);
+
+			const bool isStopping = isStopping_;
+
+			SDL_UnlockMutex(wakeMutex_);
+
+			if (isStopping) break;
+		}
+	}
+
+	int JobSystem::GetQueueIndex() const
+	{
+		return currentJobSystem == this ? currentQueueIndex : 0;
+	}
+
+	void JobSystem::PushTask(const Task& task, int queueIndex)
+	{
+		TaskQueue& taskQueue = *taskQueues_[queueIndex];
+
+		SDL_LockMutex(taskQueue.Mutex);
+		taskQueue.Tasks.push_back(task);
+		SDL_UnlockMutex(taskQueue.Mutex);
+
+		NotifyTasksQueued(1);
+	}
+
+	void JobSystem::NotifyTasksQueued(int taskCount)
+	{
+		SDL_AtomicAdd(&queuedTaskCount_, taskCount);
+
+		// Locking wakeMutex_ orders the count update before the check of a thread that is about to sleep, so no wakeup is lost
+		SDL_LockMutex(wakeMutex_);
+
+		if (taskCount == 1)
+			SDL_CondSignal(wakeCondition_);
+		else
+			SDL_CondBroadcast(wakeCondition_);
+
+		SDL_UnlockMutex(wakeMutex_);
+	}
+
+	bool JobSystem::RunNextTask(int queueIndex)
+	{
+		if (SDL_AtomicGet(&queuedTaskCount_) == 0) return false;
+
+		const int queueCount = taskQueues_.size();
+
+		// Own deque first (back, newest task), then steal from the others (front, oldest task)
+		for (int i = 0; i < queueCount; i++)
+		{
+			TaskQueue& taskQueue = *taskQueues_[(queueIndex + i) % queueCount];
+
+			SDL_LockMutex(taskQueue.Mutex);
+
+			if (taskQueue.Tasks.empty())
+			{
+				SDL_UnlockMutex(taskQueue.Mutex);
+				continue;
+			}
+
+			Task task;
+
+			if (i == 0)
+			{
+				task = taskQueue.Tasks.back();
+				taskQueue.Tasks.pop_back();
+			}
+			else
+			{
+				task = taskQueue.Tasks.front();
+				taskQueue.Tasks.pop_front();
+			}
+
+			SDL_UnlockMutex(taskQueue.Mutex);
+
+			SDL_AtomicAdd(&queuedTaskCount_, -1);
+
+			RunTask(task, queueIndex);
+			return true;
+		}
+
+		return false;
+	}
+
+	void JobSystem::RunTask(const Task& task, int queueIndex)
+	{
+		if (task.Graph)
+		{
+			TaskGraph::Node& node = task.Graph->nodes_[task.NodeIndex];
+
+			if (node.Function)
+				node.Function(node.UserData);
+
+			// Queue the dependents whose last dependency just finished
+			for (int dependentIndex : node.Dependents)
+			{
+				// SDL_AtomicAdd() returns the previous value
+				if (SDL_AtomicAdd(&task.Graph->nodes_[dependentIndex].UnresolvedCount, -1) == 1)
+				{
+					Task dependentTask = task;
+					dependentTask.NodeIndex = dependentIndex;
+
+					PushTask(dependentTask, queueIndex);
+				}
+			}
+		}
+		else
+		{
+			task.Function(task.Begin, task.End, task.UserData);
+		}
+
+		// The last task wakes up the waiting ParallelFor() or Run() call
+		if (SDL_AtomicAdd(task.RemainingCount, -1) == 1)
+		{
+			SDL_LockMutex(wakeMutex_);
+			SDL_CondBroadcast(wakeCondition_);
+			SDL_UnlockMutex(wakeMutex_);
+		}
+	}
+
+	void JobSystem::WaitFor(SDL_atomic_t* remainingCount)
+	{
+		const int queueIndex = GetQueueIndex();
+
+		while (SDL_AtomicGet(remainingCount) > 0)
+		{
+			if (RunNextTask(queueIndex)) continue;
+
+			// Nothing to help with: the remaining tasks are running on other threads
+			SDL_LockMutex(wakeMutex_);
+
+			while (SDL_AtomicGet(remainingCount) > 0 && SDL_AtomicGet(&queuedTaskCount_) == 0)
+				SDL_CondWait(wakeCondition_, wakeMutex_);
+
+			SDL_UnlockMutex(wakeMutex_);
+		}
+	}
+
+
+
+	int TaskGraph::AddTask(JobSystem::TaskFunction taskFunction, void* userData)
+	{
+		Node node;
+		node.Function = taskFunction;
+		node.UserData = userData;
+		SDL_AtomicSet(&node.UnresolvedCount, 0);
+
+		nodes_.push_back(node);
+		isValidated_ = false;
+
+		return nodes_.size() - 1;
+	}
+
+	void TaskGraph::AddDependency(int taskIndex, int prerequisiteIndex)
+	{
+		const int nodeCount = nodes_.size();
+
+		if (taskIndex < 0 || taskIndex >= nodeCount || prerequisiteIndex < 0 || prerequisiteIndex >= nodeCount || taskIndex == prerequisiteIndex)
+		{
+			ErrorLogger::Get().LogError("TaskGraph::AddDependency() failure", "Invalid task index!");
+			return;
+		}
+
+		nodes_[prerequisiteIndex].Dependents.push_back(taskIndex);
+		nodes_[taskIndex].DependencyCount++;
+		isValidated_ = false;
+	}
+
+	void TaskGraph::Clear()
+	{
+		nodes_.clear();
+		sortedIndices_.clear();
+		rootCount_ = 0;
+		isValidated_ = false;
+	}
+
+	int TaskGraph::GetTaskCount() const
+	{
+		return nodes_.size();
+	}
+
+
+
+	bool TaskGraph::Validate()
+	{
+		if (isValidated_) return true;
+
+		// Kahn's algorithm: all nodes are reachable from the roots exactly if the dependencies contain no cycle
+		const int nodeCount = nodes_.size();
+
+		std::vector<int> unresolvedCounts(nodeCount);
+		sortedIndices_.clear();
+
+		for (int i = 0; i < nodeCount; i++)
+		{
+			unresolvedCounts[i] = nodes_[i].DependencyCount;
+			if (unresolvedCounts[i] == 0) sortedIndices_.push_back(i);
+		}
+
+		rootCount_ = sortedIndices_.size();
+
+		for (int i = 0; i < (int)sortedIndices_.size(); i++)
+		{
+			for (int dependentIndex : nodes_[sortedIndices_[i]].Dependents)
+			{
+				if (--unresolvedCounts[dependentIndex] == 0)
+					sortedIndices_.push_back(dependentIndex);
+			}
+		}
+
+		if ((int)sortedIndices_.size() != nodeCount)
+		{
+			ErrorLogger::Get().LogError("TaskGraph::Validate() failure", "The task graph contains a dependency cycle!");
+			return false;
+		}
+
+		isValidated_ = true;
+		return true;
+	}
+
+}
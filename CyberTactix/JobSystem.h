@@ -0,0 +1,179 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <SDL_thread.h>
+#include <SDL_mutex.h>
+#include <SDL_atomic.h>
+#include "Uncopyable.h"
+
+namespace pix
+{
+	class TaskGraph;
+
+	// JobSystem is a work-stealing pool of worker threads for index ranges (ParallelFor), task graphs with dependencies,
+	// and a queue of tasks that must run on the main thread.
+	//
+	// Technical note:
+	// Every worker has its own task deque; the threads outside the pool (main thread, simulation thread) share one more deque.
+	// A thread pushes new tasks to its own deque and pops from its back, so nested work stays hot in its cache.
+	// Idle threads steal from the front of other deques, which holds the oldest and usually largest remaining work.
+	// Each deque has its own lock, so threads only contend when they touch the same deque.
+	// ParallelFor() and Run() block until their work is done. The waiting thread runs queued tasks meanwhile,
+	// so a JobSystem with zero workers runs everything on the calling thread, and nested calls cannot deadlock.
+	// SDL rendering and window functions must only be called on the main thread; queue such calls with RunOnMainThread().
+	//
+	// Usage:
+	// void ProcessRows(int begin, int end, void* userData) { ... } // Processes the rows [begin, end)
+	// jobSystem.ParallelFor(height, 16, ProcessRows, &myData);
+	//
+	// TaskGraph graph;
+	// const int animate = graph.AddTask(AnimateSprites, &world);
+	// const int build = graph.AddTask(BuildBatches, &world);
+	// graph.AddDependency(build, animate); // BuildBatches runs after AnimateSprites
+	// jobSystem.Run(graph);
+	//
+	// Philosophy:
+	// Jobs are plain function pointers with a userData pointer, like SDL callbacks, to avoid allocations per job.
+	// The job function must only touch data that no other batch of the same range touches.
+	// GameLoop owns a JobSystem sized from SDL_GetCPUCount(); see GameLoop::GetJobSystem().
+	class JobSystem : private Uncopyable
+	{
+	public:
+
+		// Processes the indices [begin, end) of a range
+		using JobFunction = void(*)(int begin, int end, void* userData);
+
+		// Runs a single task
+		using TaskFunction = void(*)(void* userData);
+
+		// Starts workerCount worker threads (clamped to [0, 64]).
+		// A negative workerCount starts one worker per additional CPU core (SDL_GetCPUCount() - 1).
+		explicit JobSystem(int workerCount = -1);
+
+		// Stops the worker threads. Must not be called while a ParallelFor() or Run() is running.
+		~JobSystem();
+
+		// Calls jobFunction for consecutive sub-ranges of [0, count) with at most batchSize indices each and waits for completion.
+		// batchSize is clamped to at least 1.
+		void ParallelFor(int count, int batchSize, JobFunction jobFunction, void* userData);
+
+		// Runs all tasks of the graph, each after its dependencies, and waits for completion.
+		// The graph must not be modified or run by another thread while it runs.
+		// Returns false without running anything if the dependencies contain a cycle.
+		bool Run(TaskGraph& taskGraph);
+
+		// Queues taskFunction to be called during the next ProcessMainThreadTasks(). Can be called from any thread.
+		// userData must stay valid until the task has run.
+		void RunOnMainThread(TaskFunction taskFunction, void* userData);
+
+		// Runs all tasks queued with RunOnMainThread() so far, in queue order. Must be called on the main thread.
+		// GameLoop calls this once per frame after handling events. Returns the number of tasks run.
+		int ProcessMainThreadTasks();
+
+		int GetWorkerCount() const;
+
+	private:
+
+		struct Task
+		{
+			JobFunction Function = nullptr;         // Range task if not nullptr
+			void* UserData = nullptr;
+			int Begin = 0;
+			int End = 0;
+			TaskGraph* Graph = nullptr;             // Graph task if not nullptr
+			int NodeIndex = 0;
+			SDL_atomic_t* RemainingCount = nullptr; // Unfinished tasks of the ParallelFor() or Run() call this task belongs to
+		};
+
+		struct TaskQueue
+		{
+			std::deque<Task> Tasks;
+			SDL_mutex* Mutex = nullptr;
+		};
+
+		struct MainThreadTask
+		{
+			TaskFunction Function;
+			void* UserData;
+		};
+
+		static int SDLCALL RunWorker(void* jobSystem);
+		void RunWorkerLoop(int queueIndex);
+
+		// Returns the deque of the calling thread
+		int GetQueueIndex() const;
+
+		// Pushes a task to the given deque and wakes up an idle thread
+		void PushTask(const Task& task, int queueIndex);
+
+		// Counts newly queued tasks and wakes up idle threads
+		void NotifyTasksQueued(int taskCount);
+
+		// Runs one task from the own deque or stolen from another one.
+		// Returns false if all deques are empty.
+		bool RunNextTask(int queueIndex);
+
+		void RunTask(const Task& task, int queueIndex);
+
+		// Runs tasks until remainingCount is zero
+		void WaitFor(SDL_atomic_t* remainingCount);
+
+		std::vector<SDL_Thread*> workers_;
+		std::vector<std::unique_ptr<TaskQueue>> taskQueues_; // Index 0 is shared by all threads outside the pool
+		SDL_atomic_t queuedTaskCount_;                         // Tasks in all deques
+		SDL_atomic_t startedWorkerCount_;                      // Assigns deque indices to starting workers
+		SDL_mutex* wakeMutex_ = nullptr;
+		SDL_cond* wakeCondition_ = nullptr;  // Signaled when tasks are queued or a ParallelFor() or Run() call completes
+		bool isStopping_ = false;
+
+		std::vector<MainThreadTask> mainThreadTasks_;
+		std::vector<MainThreadTask> processedMainThreadTasks_; // Swapped with mainThreadTasks_, so tasks can queue new tasks
+		SDL_mutex* mainThreadMutex_ = nullptr;
+	};
+
+
+	// TaskGraph is a set of tasks with dependencies between them, run by JobSystem::Run().
+	// A graph can be run any number of times; build it once and rerun it every frame.
+	class TaskGraph
+	{
+	public:
+
+		TaskGraph() = default;
+		~TaskGraph() = default;
+
+		// Adds a task and returns its index
+		int AddTask(JobSystem::TaskFunction taskFunction, void* userData);
+
+		// Makes the task with index taskIndex wait for the task with index prerequisiteIndex.
+		// Invalid indices are logged and ignored.
+		void AddDependency(int taskIndex, int prerequisiteIndex);
+
+		void Clear();
+
+		int GetTaskCount() const;
+
+	private:
+
+		friend class JobSystem;
+
+		struct Node
+		{
+			JobSystem::TaskFunction Function = nullptr;
+			void* UserData = nullptr;
+			std::vector<int> Dependents;
+			int DependencyCount = 0;
+			SDL_atomic_t UnresolvedCount;  // Dependencies not finished yet in the current run
+		};
+
+		// Checks the dependencies for cycles and sorts the tasks topologically, unless the graph is unchanged since the last call.
+		// Returns false if there is a cycle.
+		bool Validate();
+
+		std::vector<Node> nodes_;
+		std::vector<int> sortedIndices_; // Topological order; the first rootCount_ tasks have no dependencies
+		int rootCount_ = 0;
+		bool isValidated_ = false;
+	};
+}
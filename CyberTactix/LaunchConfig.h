@@ -26,6 +26,20 @@ namespace pix
 		bool IsIntegerScale = true;  
 		bool IsVsync = true;
 		bool IsFullscreen = false;
+
+		// Frame rate cap applied by GameLoop when vsync is off; 0 disables the cap. Ignored in headless mode, which runs at maximum speed.
+		float MaxFramesPerSecond = 240.0f;
+
+		// Captures timestamped key, button, and gamepad events for each update; see DeviceInput and InputLatencyMeter
+		bool IsInputEventCapture = false;
+
+		// Runs Update() on a simulation thread, pipelined with Render() on the main thread; see GameLoop
+		bool IsPipelined = false;
+
+		// Headless mode for benchmarking and regression tests without a display or GPU:
+		// SDL's dummy video and audio drivers are used, and rendering goes to an offscreen surface via SDL's software renderer.
+		// Vsync is disabled in headless mode, IsVsync and IsFullscreen are ignored.
+		bool IsHeadless = false;
 	};
 
 	// Immutable singleton for storing common launch settings.
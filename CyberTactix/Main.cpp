@@ -1,4 +1,6 @@
 #include <iostream>
+#include <cstring>
+#include <string>
 
 //#include "Input.h"
 
@@ -13,11 +15,57 @@
 
 #include "Gameloop.h"
 #include "ClassStyleReference.h"
+#include "Renderer.h"
+#include "RendererBenchmark.h"
+
+
+
+// Runs the renderer benchmark on the headless software renderer and writes the results into outputDirectory.
+// Usage: CyberTactix --benchmark [outputDirectory]
+int RunRendererBenchmark(std::string outputDirectory)
+{
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+    SDL_Init(SDL_INIT_VIDEO);
+
+    pix::ErrorLogger::Get().Init(pix::GameLoop::GetPrefPath("RetroMasters", "Cyber Tactix"), 4);
+
+    if (!pix::Renderer::Get().Init(910, 512, false, false, false, true))
+    {
+        SDL_Quit();
+        return 1;
+    }
+
+    if (!outputDirectory.empty() && outputDirectory.back() != '/' && outputDirectory.back() != '\\')
+        outputDirectory += '/';
+
+    bool isSuccess = false;
+
+    {
+        pix::RendererBenchmark benchmark; // Owns a texture, so it must be destroyed before the Renderer
+
+        isSuccess = benchmark.Run(pix::RendererBenchmark::Settings()) &&
+            benchmark.WriteCSV(outputDirectory + "RendererBenchmark.csv") &&
+            benchmark.WriteJSON(outputDirectory + "RendererBenchmark.json");
+
+        std::cout << "Renderer benchmark: " << benchmark.GetResults().size() << " results written to " << outputDirectory << "RendererBenchmark.csv/.json\n";
+    }
+
+    pix::Renderer::Get().Destroy();
+    SDL_Quit();
+
+    return isSuccess ? 0 : 1;
+}
 
 
 
 int main(int argc, char* argv[])
 {
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--benchmark") == 0)
+            return RunRendererBenchmark(i + 1 < argc ? argv[i + 1] : "");
+    }
+
     SDL_Init(SDL_INIT_VIDEO);
 
     pix::ErrorLogger::Get().Init(pix::GameLoop::GetPrefPath("RetroMasters", "Cyber Tactix"), 4);
@@ -2,14 +2,61 @@
 
 namespace pix
 {
+
+	namespace
+	{
+		// Pumps all enabled pumps of one concrete type with DefaultPumpFunction(), for bindings without custom pump functions.
+		// The qualified GetSourceState() call is bound at compile time and reads the DeviceState that the caller fetched once,
+		// so the loop has no per-pump dispatch at all.
+		template<typename PumpType> void PumpAllDefault(std::vector<PumpType>& pumps, const DeviceState& state)
+		{
+			const int pumpCount = pumps.size();
+
+			for (int i = 0; i < pumpCount; i++)
+			{
+				PumpType& pump = pumps[i];
+
+				if (!pump.Enabled) continue;
+
+				VirtualAxis& axis = pump.GetVirtualAxis();
+				axis.SetAxisState(AbstractInputPump::DefaultPumpFunction(pump.PumpType::GetSourceState(state), axis.GetAxisState()));
+			}
+		}
+
+		// Pumps all enabled pumps of one concrete type in binding order, choosing the default or the custom pump function per pump
+		template<typename PumpType> void PumpAll(std::vector<PumpType>& pumps, const DeviceState& state)
+		{
+			const int pumpCount = pumps.size();
+
+			for (int i = 0; i < pumpCount; i++)
+			{
+				PumpType& pump = pumps[i];
+
+				if (!pump.Enabled) continue;
+
+				const float sourceState = pump.PumpType::GetSourceState(state);
+
+				VirtualAxis& axis = pump.GetVirtualAxis();
+				const float axisState = axis.GetAxisState();
+
+				if (pump.HasCustomPumpFunction())
+					axis.SetAxisState(pump.GetPumpFunction()(sourceState, axisState));
+				else
+					axis.SetAxisState(AbstractInputPump::DefaultPumpFunction(sourceState, axisState));
+			}
+		}
+	}
+
 	// ######################################## INITIALIZATION ###################################################
 
 	ObjectInput::ObjectInput(const ObjectInput& other) :
 		virtualAxes_(other.virtualAxes_),
+		axisIDsByHandle_(other.axisIDsByHandle_),
 		keyboardInputPumps_(other.keyboardInputPumps_),
 		mouseInputPumps_(other.mouseInputPumps_),
 		gamepadInputPumps_(other.gamepadInputPumps_),
-		virtualInputPumps_(other.virtualInputPumps_)
+		virtualInputPumps_(other.virtualInputPumps_),
+		customPumpCount_(other.customPumpCount_)
 	{
 		RelinkPumpsToAxes();
 	}
@@ -20,10 +67,12 @@ namespace pix
 		if (this == &other) return *this;
 
 		virtualAxes_ = other.virtualAxes_;
+		axisIDsByHandle_ = other.axisIDsByHandle_;
 		keyboardInputPumps_ = other.keyboardInputPumps_;
 		mouseInputPumps_ = other.mouseInputPumps_;
 		gamepadInputPumps_ = other.gamepadInputPumps_;
 		virtualInputPumps_ = other.virtualInputPumps_;
+		customPumpCount_ = other.customPumpCount_;
 
 		RelinkPumpsToAxes();
 
@@ -40,10 +89,11 @@ namespace pix
 		VirtualAxis* targetAxis = GetOrAddVirtualAxis(axisName);
 		if (!targetAxis) return false;
 
-		if(GetKeyboardPumpIndex(sourceKey, axisName) >= 0) // Already exists
+		if (GetKeyboardPumpIndex(sourceKey, targetAxis->GetID()) >= 0) // Already exists
 			return false;
 
 		keyboardInputPumps_.emplace_back(sourceKey, *targetAxis, pumpFunction);
+		if (keyboardInputPumps_.back().HasCustomPumpFunction()) customPumpCount_++;
 
 		// Sync state to prevent false Became* transitions on the creation frame
 		keyboardInputPumps_.back().Pump();
@@ -54,9 +104,11 @@ namespace pix
 
 	bool ObjectInput::RemoveKeyboardBinding(SDL_Scancode sourceKey, const std::string& axisName)
 	{
-		int pumpIndex = GetKeyboardPumpIndex(sourceKey, axisName);
+		int pumpIndex = GetKeyboardPumpIndex(sourceKey, GetAxisID(axisName));
 		if (pumpIndex < 0) return false;
 		
+		if (keyboardInputPumps_[pumpIndex].HasCustomPumpFunction()) customPumpCount_--;
+
 		// Preserve binding order because pump order may affect the resulting axis state
 		keyboardInputPumps_.erase(keyboardInputPumps_.begin() + pumpIndex);
 
@@ -70,10 +122,11 @@ namespace pix
 		VirtualAxis* targetAxis = GetOrAddVirtualAxis(axisName);
 		if (!targetAxis) return false;
 
-		if (GetMousePumpIndex(sourceButton, axisName) >= 0) // Already exists
+		if (GetMousePumpIndex(sourceButton, targetAxis->GetID()) >= 0) // Already exists
 			return false;
 
 		mouseInputPumps_.emplace_back(sourceButton, *targetAxis, pumpFunction);
+		if (mouseInputPumps_.back().HasCustomPumpFunction()) customPumpCount_++;
 
 		// Sync state to prevent false Became* transitions on the creation frame
 		mouseInputPumps_.back().Pump();
@@ -84,9 +137,11 @@ namespace pix
 
 	bool ObjectInput::RemoveMouseButtonBinding(MouseInput::Button sourceButton, const std::string& axisName)
 	{
-		int pumpIndex = GetMousePumpIndex(sourceButton, axisName);
+		int pumpIndex = GetMousePumpIndex(sourceButton, GetAxisID(axisName));
 		if (pumpIndex < 0) return false;
 
+		if (mouseInputPumps_[pumpIndex].HasCustomPumpFunction()) customPumpCount_--;
+
 		// Preserve binding order because pump order may affect the resulting axis state
 		mouseInputPumps_.erase(mouseInputPumps_.begin() + pumpIndex);
 	
@@ -100,10 +155,11 @@ namespace pix
 		VirtualAxis* targetAxis = GetOrAddVirtualAxis(axisName);
 		if (!targetAxis) return false;
 
-		if (GetGamepadPumpIndex(sourceGamepadIndex, sourceButton, axisName) >= 0) // Already exists
+		if (GetGamepadPumpIndex(sourceGamepadIndex, sourceButton, targetAxis->GetID()) >= 0) // Already exists
 			return false;
 
 		gamepadInputPumps_.emplace_back(sourceGamepadIndex, sourceButton, *targetAxis, pumpFunction);
+		if (gamepadInputPumps_.back().HasCustomPumpFunction()) customPumpCount_++;
 
 		// Sync state to prevent false Became* transitions on the creation frame
 		gamepadInputPumps_.back().Pump();
@@ -114,9 +170,11 @@ namespace pix
 
 	bool ObjectInput::RemoveGamepadButtonBinding(int sourceGamepadIndex, SDL_GameControllerButton sourceButton, const std::string& axisName)
 	{
-		int pumpIndex = GetGamepadPumpIndex(sourceGamepadIndex, sourceButton, axisName);
+		int pumpIndex = GetGamepadPumpIndex(sourceGamepadIndex, sourceButton, GetAxisID(axisName));
 		if (pumpIndex < 0) return false;
 		
+		if (gamepadInputPumps_[pumpIndex].HasCustomPumpFunction()) customPumpCount_--;
+
 		// Preserve binding order because pump order may affect the resulting axis state
 		gamepadInputPumps_.erase(gamepadInputPumps_.begin() + pumpIndex);
 
@@ -130,10 +188,11 @@ namespace pix
 		VirtualAxis* targetAxis = GetOrAddVirtualAxis(axisName);
 		if (!targetAxis) return false;
 
-		if (GetGamepadPumpIndex(sourceGamepadIndex, sourceAxis, axisName) >= 0) // Already exists
+		if (GetGamepadPumpIndex(sourceGamepadIndex, sourceAxis, targetAxis->GetID()) >= 0) // Already exists
 			return false;
 
 		gamepadInputPumps_.emplace_back(sourceGamepadIndex, sourceAxis, *targetAxis, pumpFunction);
+		if (gamepadInputPumps_.back().HasCustomPumpFunction()) customPumpCount_++;
 
 		// Sync state to prevent false Became* transitions on the creation frame
 		gamepadInputPumps_.back().Pump();
@@ -144,9 +203,11 @@ namespace pix
 
 	bool ObjectInput::RemoveGamepadAxisBinding(int sourceGamepadIndex, SDL_GameControllerAxis sourceAxis, const std::string& axisName)
 	{
-		int pumpIndex = GetGamepadPumpIndex(sourceGamepadIndex, sourceAxis, axisName);
+		int pumpIndex = GetGamepadPumpIndex(sourceGamepadIndex, sourceAxis, GetAxisID(axisName));
 		if (pumpIndex < 0) return false;
 
+		if (gamepadInputPumps_[pumpIndex].HasCustomPumpFunction()) customPumpCount_--;
+
 		// Preserve binding order because pump order may affect the resulting axis state
 		gamepadInputPumps_.erase(gamepadInputPumps_.begin() + pumpIndex);
 
@@ -158,10 +219,11 @@ namespace pix
 		VirtualAxis* targetAxis = GetOrAddVirtualAxis(axisName);
 		if (!targetAxis) return false;
 
-		if (GetVirtualPumpIndex(sourceID, axisName) >= 0) // Already exists
+		if (GetVirtualPumpIndex(sourceID, targetAxis->GetID()) >= 0) // Already exists
 			return false;
 
 		virtualInputPumps_.emplace_back(sourceID, *targetAxis, pumpFunction);
+		if (virtualInputPumps_.back().HasCustomPumpFunction()) customPumpCount_++;
 
 		// Sync state to prevent false Became* transitions on the creation frame
 		virtualInputPumps_.back().Pump();
@@ -172,9 +234,11 @@ namespace pix
 
 	bool ObjectInput::RemoveVirtualBinding(int sourceID, const std::string& axisName)
 	{
-		int pumpIndex = GetVirtualPumpIndex(sourceID, axisName);
+		int pumpIndex = GetVirtualPumpIndex(sourceID, GetAxisID(axisName));
 		if (pumpIndex < 0) return false;
 
+		if (virtualInputPumps_[pumpIndex].HasCustomPumpFunction()) customPumpCount_--;
+
 		// Preserve binding order because pump order may affect the resulting axis state
 		virtualInputPumps_.erase(virtualInputPumps_.begin() + pumpIndex);
 
@@ -208,6 +272,11 @@ namespace pix
 		return SetVirtualSourceState(sourceID, GetAxisID(axisName), sourceState);
 	}
 
+	bool ObjectInput::SetVirtualSourceState(int sourceID, AxisHandle axis, float sourceState)
+	{
+		return SetVirtualSourceState(sourceID, GetAxisID(axis), sourceState);
+	}
+
 	bool ObjectInput::SetVirtualSourceState(int sourceID, int axisID, float sourceState)
 	{
 		int pumpIndex = GetVirtualPumpIndex(sourceID, axisID);
@@ -217,6 +286,78 @@ namespace pix
 		return true;
 	}
 
+	bool ObjectInput::SetVirtualSourceState(VirtualSourceHandle source, float sourceState)
+	{
+		const int pumpCount = virtualInputPumps_.size();
+
+		if (source.Index < 0 || source.Index >= pumpCount) return false;
+
+		virtualInputPumps_[source.Index].SetSourceState(sourceState);
+		return true;
+	}
+
+	int ObjectInput::SetVirtualSourceStates(const VirtualSourceState* sourceStates, int count)
+	{
+		if (!sourceStates) return 0;
+
+		const int pumpCount = virtualInputPumps_.size();
+		int setCount = 0;
+
+		for (int i = 0; i < count; i++)
+		{
+			const int pumpIndex = sourceStates[i].Source.Index;
+
+			if (pumpIndex < 0 || pumpIndex >= pumpCount) continue;
+
+			virtualInputPumps_[pumpIndex].SetSourceState(sourceStates[i].State);
+			setCount++;
+		}
+
+		return setCount;
+	}
+
+	void ObjectInput::SetVirtualSourceStates(const float* sourceStates, int count)
+	{
+		if (!sourceStates) return;
+
+		const int pumpCount = virtualInputPumps_.size();
+		if (count > pumpCount) count = pumpCount;
+
+		for (int i = 0; i < count; i++)
+			virtualInputPumps_[i].SetSourceState(sourceStates[i]);
+	}
+
+	int ObjectInput::GetVirtualSourceStates(float* sourceStates, int count) const
+	{
+		if (!sourceStates) return 0;
+
+		const int pumpCount = virtualInputPumps_.size();
+		if (count > pumpCount) count = pumpCount;
+
+		for (int i = 0; i < count; i++)
+			sourceStates[i] = virtualInputPumps_[i].GetSourceState();
+
+		return count < 0 ? 0 : count;
+	}
+
+	ObjectInput::VirtualSourceHandle ObjectInput::GetVirtualSourceHandle(int sourceID, AxisHandle axis) const
+	{
+		return GetVirtualSourceHandle(sourceID, GetAxisID(axis));
+	}
+
+	ObjectInput::VirtualSourceHandle ObjectInput::GetVirtualSourceHandle(int sourceID, int axisID) const
+	{
+		VirtualSourceHandle source;
+		source.Index = GetVirtualPumpIndex(sourceID, axisID);
+
+		return source;
+	}
+
+	int ObjectInput::GetVirtualBindingCount() const
+	{
+		return virtualInputPumps_.size();
+	}
+
 	void ObjectInput::ClearAllAxisState()
 	{
 		int axisCount = virtualAxes_.size();
@@ -277,6 +418,46 @@ namespace pix
 		return GetAxisState(GetAxisID(axisName));
 	}
 
+	bool ObjectInput::IsPositive(AxisHandle axis) const
+	{
+		return IsPositive(GetAxisID(axis));
+	}
+
+	bool ObjectInput::BecamePositive(AxisHandle axis) const
+	{
+		return BecamePositive(GetAxisID(axis));
+	}
+
+	bool ObjectInput::BecameZeroFromPositive(AxisHandle axis) const
+	{
+		return BecameZeroFromPositive(GetAxisID(axis));
+	}
+
+	bool ObjectInput::IsNegative(AxisHandle axis) const
+	{
+		return IsNegative(GetAxisID(axis));
+	}
+
+	bool ObjectInput::BecameNegative(AxisHandle axis) const
+	{
+		return BecameNegative(GetAxisID(axis));
+	}
+
+	bool ObjectInput::BecameZeroFromNegative(AxisHandle axis) const
+	{
+		return BecameZeroFromNegative(GetAxisID(axis));
+	}
+
+	bool ObjectInput::BecameZero(AxisHandle axis) const
+	{
+		return BecameZero(GetAxisID(axis));
+	}
+
+	float ObjectInput::GetAxisState(AxisHandle axis) const
+	{
+		return GetAxisState(GetAxisID(axis));
+	}
+
 	bool ObjectInput::IsPositive(int axisID) const
 	{
 		return IsValidAxisID(axisID) ? virtualAxes_[axisID].IsPositive() : false;
@@ -319,6 +500,7 @@ namespace pix
 
 	int ObjectInput::GetAxisID(const std::string& axisName) const
 	{
+		// Scans the own axes instead of asking the AxisRegistry, so name queries from worker threads do not contend for its mutex
 		const int axisCount = virtualAxes_.size();
 
 		for (int i = 0; i < axisCount; i++)
@@ -329,6 +511,11 @@ namespace pix
 
 		return -1;
 	}
+
+	int ObjectInput::GetAxisID(AxisHandle axis) const
+	{
+		return axis.ID >= 0 && axis.ID < (int)axisIDsByHandle_.size() ? axisIDsByHandle_[axis.ID] : -1;
+	}
 	
 	std::string ObjectInput::GetAxisName(int axisID) const
 	{
@@ -338,6 +525,29 @@ namespace pix
 		return virtualAxes_[axisID].GetName();
 	}
 
+	int ObjectInput::GetAxisEvents(AxisHandle axis, InputEvent* events, int maxCount) const
+	{
+		return GetAxisEvents(GetAxisID(axis), events, maxCount);
+	}
+
+	int ObjectInput::GetAxisEvents(int axisID, InputEvent* events, int maxCount) const
+	{
+		if (!events || !IsValidAxisID(axisID)) return 0;
+
+		const std::vector<InputEvent>& deviceEvents = DeviceInput::Get().GetEvents();
+		const int deviceEventCount = deviceEvents.size();
+
+		int count = 0;
+
+		for (int i = 0; i < deviceEventCount && count < maxCount; i++)
+		{
+			if (IsBoundToAxis(deviceEvents[i], axisID))
+				events[count++] = deviceEvents[i];
+		}
+
+		return count;
+	}
+
 
 	// ################################################################## PRIVATE ####################################################
 
@@ -360,25 +570,23 @@ namespace pix
 
 	void ObjectInput::PumpInput()
 	{
-		int pumpCount = keyboardInputPumps_.size();
-
-		for (int i = 0; i < pumpCount; i++)
-			keyboardInputPumps_[i].Pump();
-
-		pumpCount = mouseInputPumps_.size();
+		const DeviceState& state = DeviceInput::Get().GetState();
 
-		for (int i = 0; i < pumpCount; i++)
-			mouseInputPumps_[i].Pump();
-
-		pumpCount = gamepadInputPumps_.size();
-
-		for (int i = 0; i < pumpCount; i++)
-			gamepadInputPumps_[i].Pump();
-
-		pumpCount = virtualInputPumps_.size();
+		// Common case: only default pump functions, pumped by plain linear loops
+		if (customPumpCount_ == 0)
+		{
+			PumpAllDefault(keyboardInputPumps_, state);
+			PumpAllDefault(mouseInputPumps_, state);
+			PumpAllDefault(gamepadInputPumps_, state);
+			PumpAllDefault(virtualInputPumps_, state);
+			return;
+		}
 
-		for (int i = 0; i < pumpCount; i++)
-			virtualInputPumps_[i].Pump();
+		// Combining pump functions is order-dependent, so mixed bindings are pumped in binding order
+		PumpAll(keyboardInputPumps_, state);
+		PumpAll(mouseInputPumps_, state);
+		PumpAll(gamepadInputPumps_, state);
+		PumpAll(virtualInputPumps_, state);
 	}
 
 	void ObjectInput::RelinkPumpsToAxes()
@@ -406,106 +614,92 @@ namespace pix
 
 	VirtualAxis* ObjectInput::GetOrAddVirtualAxis(const std::string& axisName)
 	{
-		if (axisName.empty()) return nullptr;
+		const AxisHandle axisHandle = AxisRegistry::Get().Intern(axisName);
+		if (axisHandle.ID < 0) return nullptr;
 
-		VirtualAxis* axis = GetAxis(axisName);
+		const int axisID = GetAxisID(axisHandle);
+		if (axisID >= 0) return &(virtualAxes_[axisID]);
 
-		if (!axis)
-		{
-			virtualAxes_.emplace_back(axisName, virtualAxes_.size());
-			axis = &(virtualAxes_.back());
+		if (axisHandle.ID >= (int)axisIDsByHandle_.size())
+			axisIDsByHandle_.resize(axisHandle.ID + 1, -1);
 
-			RelinkPumpsToAxes(); // In case the axis vector store gets relocated, update the axis binding
-		}
+		axisIDsByHandle_[axisHandle.ID] = virtualAxes_.size();
+
+		virtualAxes_.emplace_back(axisName, virtualAxes_.size());
+
+		RelinkPumpsToAxes(); // In case the axis vector store gets relocated, update the axis binding
 
-		return axis;
+		return &(virtualAxes_.back());
 	}
 
 	VirtualAxis* ObjectInput::GetAxis(const std::string& axisName)
 	{
-		const int axisCount = virtualAxes_.size();
-
-		for (int i = 0; i < axisCount; i++)
-		{
-			if (virtualAxes_[i].GetName() == axisName)
-				return &(virtualAxes_[i]);
-		}
+		const int axisID = GetAxisID(axisName);
 
-		return nullptr;
+		return axisID >= 0 ? &(virtualAxes_[axisID]) : nullptr;
 	}
 
 	const VirtualAxis* ObjectInput::GetAxis(const std::string& axisName) const
 	{
-		const int axisCount = virtualAxes_.size();
+		const int axisID = GetAxisID(axisName);
 
-		for (int i = 0; i < axisCount; i++)
-		{
-			if (virtualAxes_[i].GetName() == axisName)
-				return &(virtualAxes_[i]);
-		}
-
-		return nullptr;
-	} 
+		return axisID >= 0 ? &(virtualAxes_[axisID]) : nullptr;
+	}
 	
-    int ObjectInput::GetKeyboardPumpIndex(SDL_Scancode sourceKey, const std::string& axisName) const
+	int ObjectInput::GetKeyboardPumpIndex(SDL_Scancode sourceKey, int axisID) const
 	{
+		if (!IsValidAxisID(axisID)) return -1;
+
 		const int pumpCount = keyboardInputPumps_.size();
 
 		for (int i = 0; i < pumpCount; i++)
 		{
-			if (keyboardInputPumps_[i].GetSourceKey() == sourceKey && keyboardInputPumps_[i].GetVirtualAxis().GetName() == axisName)
+			if (keyboardInputPumps_[i].GetSourceKey() == sourceKey && keyboardInputPumps_[i].GetCachedAxisID() == axisID)
 				return i;
 		}
 
 		return -1;
 	}
 
-	int ObjectInput::GetMousePumpIndex(MouseInput::Button sourceButton, const std::string& axisName) const
+	int ObjectInput::GetMousePumpIndex(MouseInput::Button sourceButton, int axisID) const
 	{
+		if (!IsValidAxisID(axisID)) return -1;
+
 		const int pumpCount = mouseInputPumps_.size();
 
 		for (int i = 0; i < pumpCount; i++)
 		{
-			if (mouseInputPumps_[i].GetSourceButton() == sourceButton && mouseInputPumps_[i].GetVirtualAxis().GetName() == axisName)
+			if (mouseInputPumps_[i].GetSourceButton() == sourceButton && mouseInputPumps_[i].GetCachedAxisID() == axisID)
 				return i;
 		}
 
 		return -1;
 	}
 
-	int ObjectInput::GetGamepadPumpIndex(int sourceGamepadIndex, SDL_GameControllerButton sourceButton, const std::string& axisName) const
+	int ObjectInput::GetGamepadPumpIndex(int sourceGamepadIndex, SDL_GameControllerButton sourceButton, int axisID) const
 	{
-		const int pumpCount = gamepadInputPumps_.size();
-
-		for (int i = 0; i < pumpCount; i++)
-		{
-			if (gamepadInputPumps_[i].GetSourceGamepadIndex() == sourceGamepadIndex && gamepadInputPumps_[i].GetSourceButton() == sourceButton && gamepadInputPumps_[i].GetVirtualAxis().GetName() == axisName)
-				return i;
-		}
-
-		return -1;
-	}
+		if (!IsValidAxisID(axisID)) return -1;
 
-	int ObjectInput::GetGamepadPumpIndex(int sourceGamepadIndex, SDL_GameControllerAxis sourceAxis, const std::string& axisName) const
-	{
 		const int pumpCount = gamepadInputPumps_.size();
 
 		for (int i = 0; i < pumpCount; i++)
 		{
-			if (gamepadInputPumps_[i].GetSourceGamepadIndex() == sourceGamepadIndex && gamepadInputPumps_[i].GetSourceAxis() == sourceAxis && gamepadInputPumps_[i].GetVirtualAxis().GetName() == axisName)
+			if (gamepadInputPumps_[i].GetSourceGamepadIndex() == sourceGamepadIndex && gamepadInputPumps_[i].GetSourceButton() == sourceButton && gamepadInputPumps_[i].GetCachedAxisID() == axisID)
 				return i;
 		}
 
 		return -1;
 	}
 
-	int ObjectInput::GetVirtualPumpIndex(int sourceID, const std::string& axisName) const
+	int ObjectInput::GetGamepadPumpIndex(int sourceGamepadIndex, SDL_GameControllerAxis sourceAxis, int axisID) const
 	{
-		const int pumpCount = virtualInputPumps_.size();
+		if (!IsValidAxisID(axisID)) return -1;
+
+		const int pumpCount = gamepadInputPumps_.size();
 
 		for (int i = 0; i < pumpCount; i++)
 		{
-			if (virtualInputPumps_[i].GetSourceID() == sourceID && virtualInputPumps_[i].GetVirtualAxis().GetName() == axisName)
+			if (gamepadInputPumps_[i].GetSourceGamepadIndex() == sourceGamepadIndex && gamepadInputPumps_[i].GetSourceAxis() == sourceAxis && gamepadInputPumps_[i].GetCachedAxisID() == axisID)
 				return i;
 		}
 
@@ -532,4 +726,24 @@ namespace pix
 		return axisID >= 0 && axisID < virtualAxes_.size();
 	}
 
+	bool ObjectInput::IsBoundToAxis(const InputEvent& event, int axisID) const
+	{
+		switch (event.Source)
+		{
+		case InputEvent::KEY:
+			return GetKeyboardPumpIndex((SDL_Scancode)event.Code, axisID) != -1;
+
+		case InputEvent::MOUSE_BUTTON:
+			return GetMousePumpIndex((MouseInput::Button)event.Code, axisID) != -1;
+
+		case InputEvent::GAMEPAD_BUTTON:
+			return GetGamepadPumpIndex(event.GamepadIndex, (SDL_GameControllerButton)event.Code, axisID) != -1;
+
+		case InputEvent::GAMEPAD_AXIS:
+			return GetGamepadPumpIndex(event.GamepadIndex, (SDL_GameControllerAxis)event.Code, axisID) != -1;
+		}
+
+		return false;
+	}
+
 }
\ No newline at end of file
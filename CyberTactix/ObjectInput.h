@@ -2,6 +2,8 @@
 
 #include <vector>
 #include "InputPumps.h"
+#include "AxisRegistry.h"
+#include "DeviceInput.h"
 
 namespace pix
 {
@@ -10,6 +12,8 @@ namespace pix
 	// 
 	// Technical note:
 	// In general, transient input state (Became* input actions) is either update-based or render-frame-based, and must not be mixed.
+	// Axis names are interned in the AxisRegistry. A flat table maps AxisHandle IDs to the axes of this ObjectInput,
+	// so queries by AxisHandle or by axis ID are array lookups. Queries by name compare the axis names on every call and are deprecated.
 	// 
 	// Philosophy:
 	// ObjectInput provides an isolated, configurable input context per consumer.
@@ -20,6 +24,21 @@ namespace pix
 
 	public:
 
+		// Index of a virtual binding, resolved once with GetVirtualSourceHandle() so that setting its source state needs no search.
+		// Index -1 is the invalid handle. Removing a virtual binding invalidates the handles of all virtual bindings;
+		// adding bindings keeps them valid.
+		struct VirtualSourceHandle
+		{
+			int Index = -1;
+		};
+
+		// A virtual source state for SetVirtualSourceStates()
+		struct VirtualSourceState
+		{
+			VirtualSourceHandle Source;
+			float State = 0.0f;
+		};
+
 		// ######################################## INITIALIZATION ###################################################
 
 		ObjectInput() = default;
@@ -68,12 +87,42 @@ namespace pix
 
 		// Sets the state of a code-driven virtual input source.
 		// Returns false if sourceID and axisName do not match an existing virtual binding, true otherwise.
+		// Deprecated, use the AxisHandle overload.
 		bool SetVirtualSourceState(int sourceID, const std::string& axisName, float sourceState);
 
+		// Overload that takes an interned axis handle instead of axis name.
+		// Returns false if sourceID and axis do not match an existing virtual binding, true otherwise.
+		bool SetVirtualSourceState(int sourceID, AxisHandle axis, float sourceState);
+
 		// Overload that takes axis ID instead of axis name.
 		// Returns false if sourceID and axisID do not match an existing virtual binding, true otherwise.
 		bool SetVirtualSourceState(int sourceID, int axisID, float sourceState);
 
+		// Sets the state of the virtual source bound through the handle.
+		// Returns false if the handle is invalid, true otherwise.
+		bool SetVirtualSourceState(VirtualSourceHandle source, float sourceState);
+
+		// Sets the states of many virtual sources in one call, e.g. all inputs of an AI agent for this update.
+		// Entries with invalid handles are skipped. Returns the number of states set.
+		int SetVirtualSourceStates(const VirtualSourceState* sourceStates, int count);
+
+		// Sets the states of the virtual bindings in binding order: sourceStates[i] goes to the i-th virtual binding.
+		// Extra states are ignored; bindings beyond count keep their state. Suited for AI agents that produce a dense state vector.
+		void SetVirtualSourceStates(const float* sourceStates, int count);
+
+		// Copies the source states of the virtual bindings in binding order, e.g. to record them with InputRecorder.
+		// Returns the number of states copied, which is at most count.
+		int GetVirtualSourceStates(float* sourceStates, int count) const;
+
+		// Returns the handle of the virtual binding of sourceID to the axis, or the invalid handle if there is none
+		VirtualSourceHandle GetVirtualSourceHandle(int sourceID, AxisHandle axis) const;
+
+		// Overload that takes axis ID instead of axis handle
+		VirtualSourceHandle GetVirtualSourceHandle(int sourceID, int axisID) const;
+
+		// Returns the number of virtual bindings, which is the size of a full state vector for SetVirtualSourceStates()
+		int GetVirtualBindingCount() const;
+
 		// Clears the previous and current state of all axes to zero
 		void ClearAllAxisState();
 
@@ -84,29 +133,51 @@ namespace pix
 		// ################################################################## CHECK INPUT ####################################################
 
 		// Returns true if current axis state is positive, false otherwise
+		// Deprecated, use the AxisHandle overload.
 		bool IsPositive(const std::string& axisName) const;
 
 		// Returns true if axis state was not positive and became positive in the current update iteration, false otherwise
+		// Deprecated, use the AxisHandle overload.
 		bool BecamePositive(const std::string& axisName) const;
 
 		// Returns true if axis state was positive and became zero in the current update iteration, false otherwise
+		// Deprecated, use the AxisHandle overload.
 		bool BecameZeroFromPositive(const std::string& axisName) const;
 
 		// Returns true if current axis state is negative, false otherwise
+		// Deprecated, use the AxisHandle overload.
 		bool IsNegative(const std::string& axisName) const;
 
 		// Returns true if axis state was not negative and became negative in the current update iteration, false otherwise
+		// Deprecated, use the AxisHandle overload.
 		bool BecameNegative(const std::string& axisName) const;
 
 		// Returns true if axis state was negative and became zero in the current update iteration, false otherwise
+		// Deprecated, use the AxisHandle overload.
 		bool BecameZeroFromNegative(const std::string& axisName) const;
 
 		// Returns true if axis state was not zero and became zero in the current update iteration, false otherwise
+		// Deprecated, use the AxisHandle overload.
 		bool BecameZero(const std::string& axisName) const;
 
 		// Returns current axis state
+		// Deprecated, use the AxisHandle overload.
 		float GetAxisState(const std::string& axisName) const;
 
+		// The following overloads operate on interned axis handles; see AxisRegistry.
+		// Boolean input checks return false if this ObjectInput has no axis for the handle.
+
+		bool IsPositive(AxisHandle axis) const;
+		bool BecamePositive(AxisHandle axis) const;
+		bool BecameZeroFromPositive(AxisHandle axis) const;
+		bool IsNegative(AxisHandle axis) const;
+		bool BecameNegative(AxisHandle axis) const;
+		bool BecameZeroFromNegative(AxisHandle axis) const;
+		bool BecameZero(AxisHandle axis) const;
+
+		// Returns current axis state or 0.0f if this ObjectInput has no axis for the handle
+		float GetAxisState(AxisHandle axis) const;
+
 		// The following overloads operate on cached axis IDs to avoid string lookup.
 		// Boolean input checks return false on invalid axis ID.
 
@@ -137,9 +208,22 @@ namespace pix
 		// Returns -1 (invalid axis ID) if no axis matches axisName
 	    int GetAxisID(const std::string& axisName) const;
 
+		// Returns -1 (invalid axis ID) if this ObjectInput has no axis for the handle
+		int GetAxisID(AxisHandle axis) const;
+
 		// Returns an empty string if no axis matches axisID
 		std::string GetAxisName(int axisID) const;
 
+		// ################################################################## INPUT EVENTS ####################################################
+
+		// Copies the device events of the current update whose source is bound to the axis, in the order SDL received them.
+		// The SDL timestamps tell when within the frame the axis sources changed. Requires event capture; see DeviceInput.
+		// Returns the number of events copied, which is at most maxCount.
+		int GetAxisEvents(AxisHandle axis, InputEvent* events, int maxCount) const;
+
+		// Overload that takes axis ID instead of axis handle
+		int GetAxisEvents(int axisID, InputEvent* events, int maxCount) const;
+
 	private:
 
 		void SyncPreviousInput();
@@ -158,26 +242,31 @@ namespace pix
 
 		const VirtualAxis* GetAxis(const std::string& axisName) const;
 
-		int GetKeyboardPumpIndex(SDL_Scancode sourceKey, const std::string& axisName) const;
+		// Pump searches compare the cached axis IDs; they return -1 if there is no match or axisID is invalid
 
-		int GetMousePumpIndex(MouseInput::Button sourceButton, const std::string& axisName) const;
+		int GetKeyboardPumpIndex(SDL_Scancode sourceKey, int axisID) const;
 
-		int GetGamepadPumpIndex(int sourceGamepadIndex, SDL_GameControllerButton sourceButton, const std::string& axisName) const;
+		int GetMousePumpIndex(MouseInput::Button sourceButton, int axisID) const;
 
-		int GetGamepadPumpIndex(int sourceGamepadIndex, SDL_GameControllerAxis sourceAxis, const std::string& axisName) const;
+		int GetGamepadPumpIndex(int sourceGamepadIndex, SDL_GameControllerButton sourceButton, int axisID) const;
 
-		int GetVirtualPumpIndex(int sourceID, const std::string& axisName) const;
+		int GetGamepadPumpIndex(int sourceGamepadIndex, SDL_GameControllerAxis sourceAxis, int axisID) const;
 
 		int GetVirtualPumpIndex(int sourceID, int axisID) const;
 
 		bool IsValidAxisID(int axisID) const;
+
+		// Returns true if the source of the event is bound to the axis, false otherwise
+		bool IsBoundToAxis(const InputEvent& event, int axisID) const;
 		
 	
 		std::vector<VirtualAxis> virtualAxes_;
+		std::vector<int> axisIDsByHandle_; // Maps AxisHandle IDs to axis IDs, -1 for axes this ObjectInput does not have
 		std::vector<KeyboardInputPump> keyboardInputPumps_;
 		std::vector<MouseButtonInputPump> mouseInputPumps_;
 		std::vector<GamepadInputPump> gamepadInputPumps_;
 		std::vector<VirtualInputPump> virtualInputPumps_;
+		int customPumpCount_ = 0; // Bindings with a custom pump function, over all pump types
 
 	};
 
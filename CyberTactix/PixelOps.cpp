@@ -0,0 +1,330 @@
+#include "PixelOps.h"
+#include <cstring>
+#include <algorithm>
+#include "ErrorLogger.h"
+#include "PixMath.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PIX_PIXELOPS_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace pix
+{
+	namespace
+	{
+		constexpr int ROWS_PER_BATCH = 16; // Large enough to keep the job queue out of the hot path
+
+		// Runs rowJob for the rows [0, rowCount), split across the workers of jobSystem if available
+		void RunRows(int rowCount, JobSystem::JobFunction rowJob, void* userData, JobSystem* jobSystem)
+		{
+			if (jobSystem)
+				jobSystem->ParallelFor(rowCount, ROWS_PER_BATCH, rowJob, userData);
+			else
+				rowJob(0, rowCount, userData);
+		}
+
+		// Blends one RGBA32 source pixel over one target pixel like SDL_BLENDMODE_BLEND:
+		// rgb = src.rgb * src.a + dst.rgb * (1 - src.a), a = src.a + dst.a * (1 - src.a)
+		Uint32 GetBlendedPixel(Uint32 sourcePixel, Uint32 targetPixel)
+		{
+			const Uint8* source = (const Uint8*)&sourcePixel;
+			const Uint8* target = (const Uint8*)&targetPixel;
+
+			const int alpha = source[3];
+			const int inverseAlpha = 255 - alpha;
+
+			Uint32 blendedPixel;
+			Uint8* blended = (Uint8*)&blendedPixel;
+
+			for (int i = 0; i < 3; i++)
+			{
+				const int value = source[i] * alpha + target[i] * inverseAlpha + 128;
+				blended[i] = (Uint8)((value + (value >> 8)) >> 8); // Exact division by 255 with rounding
+			}
+
+			const int value = alpha * 255 + target[3] * inverseAlpha + 128;
+			blended[3] = (Uint8)((value + (value >> 8)) >> 8);
+
+			return blendedPixel;
+		}
+
+		void BlendRow(Uint32* target, const Uint32* source, int width)
+		{
+			int x = 0;
+
+#ifdef PIX_PIXELOPS_SSE2
+			// 4 pixels per iteration, 2 pixels per 128-bit register of 16-bit channels.
+			// The source factor of the alpha channel is 255 instead of src.a, so one formula covers rgb and alpha.
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i rgbMask = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+			const __m128i alphaOne = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+			const __m128i max = _mm_set1_epi16(255);
+			const __m128i rounding = _mm_set1_epi16(128);
+
+			for (; x + 4 <= width; x += 4)
+			{
+				const __m128i sourcePixels = _mm_loadu_si128((const __m128i*)(source + x));
+				const __m128i targetPixels = _mm_loadu_si128((const __m128i*)(target + x));
+
+				__m128i result[2];
+
+				for (int half = 0; half < 2; half++)
+				{
+					const __m128i sourceChannels = half == 0 ? _mm_unpacklo_epi8(sourcePixels, zero) : _mm_unpackhi_epi8(sourcePixels, zero);
+					const __m128i targetChannels = half == 0 ? _mm_unpacklo_epi8(targetPixels, zero) : _mm_unpackhi_epi8(targetPixels, zero);
+
+					// Broadcast the alpha of each pixel to its four channels
+					__m128i alpha = _mm_shufflelo_epi16(sourceChannels, _MM_SHUFFLE(3, 3, 3, 3));
+					alpha = _mm_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+
+					const __m128i sourceFactor = _mm_or_si128(_mm_and_si128(alpha, rgbMask), alphaOne);
+					const __m128i targetFactor = _mm_sub_epi16(max, alpha);
+
+					__m128i value = _mm_add_epi16(_mm_mullo_epi16(sourceChannels, sourceFactor), _mm_mullo_epi16(targetChannels, targetFactor));
+					value = _mm_add_epi16(value, rounding);
+					result[half] = _mm_srli_epi16(_mm_add_epi16(value, _mm_srli_epi16(value, 8)), 8);
+				}
+
+				_mm_storeu_si128((__m128i*)(target + x), _mm_packus_epi16(result[0], result[1]));
+			}
+#endif
+
+			for (; x < width; x++)
+				target[x] = GetBlendedPixel(source[x], target[x]);
+		}
+
+
+
+		struct FillJob
+		{
+			PixelBuffer* Target;
+			Uint32 Pixel;
+		};
+
+		void FillRows(int begin, int end, void* userData)
+		{
+			const FillJob& job = *(const FillJob*)userData;
+
+			for (int y = begin; y < end; y++)
+				std::fill_n(job.Target->GetRow(y), job.Target->Width, job.Pixel);
+		}
+
+		struct BlitJob
+		{
+			PixelBuffer Target; // Clipped target region
+			PixelBuffer Source; // Clipped source region of the same size
+			bool IsAlphaBlend;
+		};
+
+		void BlitRows(int begin, int end, void* userData)
+		{
+			const BlitJob& job = *(const BlitJob*)userData;
+
+			for (int y = begin; y < end; y++)
+			{
+				if (job.IsAlphaBlend)
+					BlendRow(job.Target.GetRow(y), job.Source.GetRow(y), job.Target.Width);
+				else
+					std::memcpy(job.Target.GetRow(y), job.Source.GetRow(y), job.Target.Width * sizeof(Uint32));
+			}
+		}
+
+		struct PaletteJob
+		{
+			PixelBuffer* Target;
+			const Uint8* Indices;
+			int IndexPitch;
+			const Uint32* Palette;
+		};
+
+		void PaletteRows(int begin, int end, void* userData)
+		{
+			const PaletteJob& job = *(const PaletteJob*)userData;
+			const int width = job.Target->Width;
+
+			for (int y = begin; y < end; y++)
+			{
+				Uint32* row = job.Target->GetRow(y);
+				const Uint8* indexRow = job.Indices + y * job.IndexPitch;
+
+				for (int x = 0; x < width; x++)
+					row[x] = job.Palette[indexRow[x]];
+			}
+		}
+
+		struct ScrollJob
+		{
+			PixelBuffer* Target;
+			const PixelBuffer* Source;
+			int OffsetX; // Wrapped into [0, Source->Width)
+			int OffsetY; // Wrapped into [0, Source->Height)
+			int Width;   // Width of the written area
+		};
+
+		void ScrollRows(int begin, int end, void* userData)
+		{
+			const ScrollJob& job = *(const ScrollJob*)userData;
+			const int sourceWidth = job.Source->Width;
+
+			for (int y = begin; y < end; y++)
+			{
+				Uint32* row = job.Target->GetRow(y);
+				const Uint32* sourceRow = job.Source->GetRow((y + job.OffsetY) % job.Source->Height);
+
+				// Copy the row in at most two segments per wrap of the source row
+				int x = 0;
+				int sourceX = job.OffsetX;
+
+				while (x < job.Width)
+				{
+					const int segmentWidth = std::min(job.Width - x, sourceWidth - sourceX);
+					std::memcpy(row + x, sourceRow + sourceX, segmentWidth * sizeof(Uint32));
+
+					x += segmentWidth;
+					sourceX = 0;
+				}
+			}
+		}
+
+		struct ShaderJob
+		{
+			PixelBuffer* Target;
+			PixelShader Shader;
+			void* UserData;
+		};
+
+		void ShadeRows(int begin, int end, void* userData)
+		{
+			const ShaderJob& job = *(const ShaderJob*)userData;
+			const int width = job.Target->Width;
+
+			for (int y = begin; y < end; y++)
+			{
+				Uint32* row = job.Target->GetRow(y);
+
+				for (int x = 0; x < width; x++)
+					row[x] = job.Shader(x, y, row[x], job.UserData);
+			}
+		}
+	}
+
+
+
+	bool LockPixelBuffer(StreamingTexture& texture, const SDL_Rect* rect, PixelBuffer& buffer)
+	{
+		void* pixels = nullptr;
+		int pitch = 0;
+
+		if (!texture.Lock(rect, &pixels, &pitch)) return false;
+
+		buffer.Pixels = (Uint32*)pixels;
+		buffer.Pitch = pitch;
+
+		if (rect)
+		{
+			buffer.Width = rect->w;
+			buffer.Height = rect->h;
+		}
+		else
+		{
+			texture.GetSize(buffer.Width, buffer.Height);
+		}
+
+		return true;
+	}
+
+	PixelBuffer GetPixelSubBuffer(const PixelBuffer& buffer, const SDL_Rect& rect)
+	{
+		const int left = GetClamped(rect.x, 0, buffer.Width);
+		const int top = GetClamped(rect.y, 0, buffer.Height);
+		const int right = GetClamped(rect.x + rect.w, left, buffer.Width);
+		const int bottom = GetClamped(rect.y + rect.h, top, buffer.Height);
+
+		PixelBuffer subBuffer;
+		subBuffer.Pixels = buffer.Pixels ? buffer.GetRow(top) + left : nullptr;
+		subBuffer.Width = right - left;
+		subBuffer.Height = bottom - top;
+		subBuffer.Pitch = buffer.Pitch;
+
+		return subBuffer;
+	}
+
+	Uint32 GetPackedPixel(SDL_Color color)
+	{
+		Uint32 pixel;
+		std::memcpy(&pixel, &color, sizeof(pixel)); // SDL_Color is laid out as R, G, B, A like RGBA32
+
+		return pixel;
+	}
+
+	void FillPixels(PixelBuffer& target, SDL_Color color, JobSystem* jobSystem)
+	{
+		if (!target.Pixels) return;
+
+		FillJob job = { &target, GetPackedPixel(color) };
+		RunRows(target.Height, FillRows, &job, jobSystem);
+	}
+
+	void BlitPixels(PixelBuffer& target, int x, int y, const PixelBuffer& source, bool isAlphaBlend, JobSystem* jobSystem)
+	{
+		if (!target.Pixels || !source.Pixels) return;
+
+		const SDL_Rect targetRect = { x, y, source.Width, source.Height };
+
+		BlitJob job;
+		job.Target = GetPixelSubBuffer(target, targetRect);
+
+		// Skip the source pixels that were clipped off at the top-left of the target
+		const SDL_Rect sourceRect = { (x < 0 ? -x : 0), (y < 0 ? -y : 0), job.Target.Width, job.Target.Height };
+		job.Source = GetPixelSubBuffer(source, sourceRect);
+		job.IsAlphaBlend = isAlphaBlend;
+
+		if (job.Target.Width <= 0 || job.Target.Height <= 0) return;
+
+		RunRows(job.Target.Height, BlitRows, &job, jobSystem);
+	}
+
+	void BlitPalettized(PixelBuffer& target, const Uint8* indices, int indexPitch, const Uint32* palette, JobSystem* jobSystem)
+	{
+		if (!target.Pixels) return;
+
+		if (!indices || !palette)
+		{
+			ErrorLogger::Get().LogError("BlitPalettized() failure", "indices or palette is nullptr!");
+			return;
+		}
+
+		PaletteJob job = { &target, indices, indexPitch, palette };
+		RunRows(target.Height, PaletteRows, &job, jobSystem);
+	}
+
+	void ScrollPixels(PixelBuffer& target, const PixelBuffer& source, int offsetX, int offsetY, JobSystem* jobSystem)
+	{
+		if (!target.Pixels || !source.Pixels || source.Width <= 0 || source.Height <= 0) return;
+
+		ScrollJob job;
+		job.Target = &target;
+		job.Source = &source;
+		job.OffsetX = ((offsetX % source.Width) + source.Width) % source.Width;
+		job.OffsetY = ((offsetY % source.Height) + source.Height) % source.Height;
+		job.Width = std::min(target.Width, source.Width);
+
+		RunRows(std::min(target.Height, source.Height), ScrollRows, &job, jobSystem);
+	}
+
+	void ShadePixels(PixelBuffer& target, PixelShader shader, void* userData, JobSystem* jobSystem)
+	{
+		if (!target.Pixels) return;
+
+		if (!shader)
+		{
+			ErrorLogger::Get().LogError("ShadePixels() failure", "shader is nullptr!");
+			return;
+		}
+
+		ShaderJob job = { &target, shader, userData };
+		RunRows(target.Height, ShadeRows, &job, jobSystem);
+	}
+
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <SDL_rect.h>
+#include <SDL_pixels.h>
+#include "StreamingTexture.h"
+#include "JobSystem.h"
+
+namespace pix
+{
+	// PixelBuffer is a non-owning view of RGBA32 pixels, e.g. the memory of a locked StreamingTexture or a CPU-side image.
+	// Pixels are stored in R, G, B, A byte order, rows are Pitch bytes apart.
+	struct PixelBuffer
+	{
+		Uint32* Pixels = nullptr; // Top-left pixel
+		int Width = 0;
+		int Height = 0;
+		int Pitch = 0;            // Bytes per row
+
+		Uint32* GetRow(int y) const { return (Uint32*)((Uint8*)Pixels + y * Pitch); }
+	};
+
+	// Computes the color of the pixel at (x, y). pixel is the current value of that pixel in the target buffer.
+	// Note: The memory of a locked StreamingTexture is undefined, so pixel is only meaningful for CPU-side buffers.
+	using PixelShader = Uint32(*)(int x, int y, Uint32 pixel, void* userData);
+
+
+
+	// The pixel kernels below process the rows of the target buffer in parallel if a jobSystem is provided,
+	// and on the calling thread if jobSystem is nullptr. SSE2 is used for 32-bit RGBA blending where available.
+	// Source and target buffers must not overlap.
+
+	// Locks the region rect of texture (nullptr = whole texture) and describes the locked memory in buffer.
+	// The texture must be unlocked after writing, as with StreamingTexture::Lock().
+	// Returns true on success, false otherwise.
+	bool LockPixelBuffer(StreamingTexture& texture, const SDL_Rect* rect, PixelBuffer& buffer);
+
+	// Returns a view of the region rect of buffer. rect is clipped to the buffer.
+	PixelBuffer GetPixelSubBuffer(const PixelBuffer& buffer, const SDL_Rect& rect);
+
+	// Returns color packed as one RGBA32 pixel, independent of the byte order of the platform
+	Uint32 GetPackedPixel(SDL_Color color);
+
+	// Sets all pixels of target to color
+	void FillPixels(PixelBuffer& target, SDL_Color color, JobSystem* jobSystem = nullptr);
+
+	// Copies source to target with its top-left corner at (x, y), clipped to target.
+	// If isAlphaBlend is true, source is blended over target like SDL_BLENDMODE_BLEND; otherwise pixels are copied as they are.
+	void BlitPixels(PixelBuffer& target, int x, int y, const PixelBuffer& source, bool isAlphaBlend = true, JobSystem* jobSystem = nullptr);
+
+	// Converts 8-bit palette indices to pixels: target(x, y) = palette[indices(x, y)].
+	// indices covers target.Width x target.Height bytes with indexPitch bytes per row; palette holds 256 packed pixels.
+	void BlitPalettized(PixelBuffer& target, const Uint8* indices, int indexPitch, const Uint32* palette, JobSystem* jobSystem = nullptr);
+
+	// Copies source to target, scrolled with wrap-around: target(x, y) = source((x + offsetX) mod w, (y + offsetY) mod h).
+	// Only the area covered by both buffers is written. Intended for endlessly scrolling background layers.
+	void ScrollPixels(PixelBuffer& target, const PixelBuffer& source, int offsetX, int offsetY, JobSystem* jobSystem = nullptr);
+
+	// Sets every pixel of target to shader(x, y, pixel, userData).
+	// With a jobSystem, shader is called concurrently from multiple threads and must only read shared data.
+	void ShadePixels(PixelBuffer& target, PixelShader shader, void* userData, JobSystem* jobSystem = nullptr);
+}
+
+
+// Example usage: Render a palette-cycled retro layer into a streaming texture using all CPU cores
+/*
+PixelBuffer pixels;
+
+if (LockPixelBuffer(streamingTexture, nullptr, pixels))
+{
+	BlitPalettized(pixels, indexImage, indexImageWidth, cycledPalette, &jobSystem);
+	BlitPixels(pixels, playerX, playerY, playerSprite, true, &jobSystem);
+
+	streamingTexture.Unlock();
+}
+*/
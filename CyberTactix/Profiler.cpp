@@ -0,0 +1,227 @@
+#include "Profiler.h"
+#include <SDL_timer.h>
+#include <SDL_rwops.h>
+#include "ErrorLogger.h"
+
+namespace pix
+{
+
+	Profiler& Profiler::Get()
+	{
+		static Profiler profiler_;
+		return profiler_;
+	}
+
+	void Profiler::RecordZone(const char* name, Uint64 startCounter, Uint64 endCounter)
+	{
+		ThreadBuffer* threadBuffer = GetThreadBuffer();
+		if (!threadBuffer) return;
+
+		const Uint32 writeCount = (Uint32)SDL_AtomicGet(&threadBuffer->WriteCount);
+
+		// A full buffer drops the new zone, so that EndFrame() never reads a slot that is being overwritten
+		if (writeCount - (Uint32)SDL_AtomicGet(&threadBuffer->ReadCount) >= (Uint32)EVENT_CAPACITY)
+		{
+			SDL_AtomicIncRef(&threadBuffer->DroppedCount);
+			return;
+		}
+
+		Event& event = threadBuffer->Events[writeCount & (EVENT_CAPACITY - 1)];
+		event.Name = name;
+		event.StartCounter = startCounter;
+		event.EndCounter = endCounter;
+
+		// Publish the event; SDL_AtomicSet() is a full memory barrier
+		SDL_AtomicSet(&threadBuffer->WriteCount, (int)(writeCount + 1));
+	}
+
+	void Profiler::EndFrame()
+	{
+		const Uint64 frameEndCounter = SDL_GetPerformanceCounter();
+		const double countsPerMillisecond = SDL_GetPerformanceFrequency() / 1000.0;
+
+		if (frameStartCounter_ != 0)
+			frameMilliseconds_ = (frameEndCounter - frameStartCounter_) / countsPerMillisecond;
+
+		frameStartCounter_ = frameEndCounter;
+
+		frameStatistics_.clear();
+		statisticsIndices_.clear();
+
+		SDL_LockMutex(mutex_);
+
+		for (const std::unique_ptr<ThreadBuffer>& threadBuffer : threadBuffers_)
+		{
+			const Uint32 writeCount = (Uint32)SDL_AtomicGet(&threadBuffer->WriteCount);
+			Uint32 readCount = (Uint32)SDL_AtomicGet(&threadBuffer->ReadCount);
+
+			droppedZoneCount_ += SDL_AtomicSet(&threadBuffer->DroppedCount, 0);
+
+			// Unsigned arithmetic keeps the counts valid across wrap-around
+			for (; readCount != writeCount; readCount++)
+			{
+				const Event& event = threadBuffer->Events[readCount & (EVENT_CAPACITY - 1)];
+				const double milliseconds = (event.EndCounter - event.StartCounter) / countsPerMillisecond;
+
+				auto it = statisticsIndices_.find(event.Name);
+
+				if (it == statisticsIndices_.end())
+				{
+					it = statisticsIndices_.emplace(event.Name, (int)frameStatistics_.size()).first;
+
+					ZoneStatistics zoneStatistics;
+					zoneStatistics.Name = event.Name;
+					frameStatistics_.push_back(zoneStatistics);
+				}
+
+				ZoneStatistics& zoneStatistics = frameStatistics_[it->second];
+				zoneStatistics.TotalMilliseconds += milliseconds;
+				if (milliseconds > zoneStatistics.MaxMilliseconds) zoneStatistics.MaxMilliseconds = milliseconds;
+				zoneStatistics.CallCount++;
+
+				if (isCapturing_)
+					capturedEvents_.push_back(CapturedEvent{ event, threadBuffer->ThreadID });
+			}
+
+			// Releases the read slots to the writer; SDL_AtomicSet() is a full memory barrier
+			SDL_AtomicSet(&threadBuffer->ReadCount, (int)readCount);
+		}
+
+		SDL_UnlockMutex(mutex_);
+	}
+
+	const std::vector<Profiler::ZoneStatistics>& Profiler::GetFrameStatistics() const
+	{
+		return frameStatistics_;
+	}
+
+	double Profiler::GetFrameMilliseconds() const
+	{
+		return frameMilliseconds_;
+	}
+
+	int Profiler::GetDroppedZoneCount() const
+	{
+		return droppedZoneCount_;
+	}
+
+	void Profiler::BeginCapture()
+	{
+		capturedEvents_.clear();
+		captureStartCounter_ = SDL_GetPerformanceCounter();
+		isCapturing_ = true;
+	}
+
+	bool Profiler::EndCapture(const std::string& outputPath)
+	{
+		if (!isCapturing_)
+		{
+			ErrorLogger::Get().LogError("Profiler::EndCapture() failure", "No capture is running!");
+			return false;
+		}
+
+		isCapturing_ = false;
+
+		// Chrome trace format: complete events ("ph": "X") with timestamps and durations in microseconds
+		const double countsPerMicrosecond = SDL_GetPerformanceFrequency() / 1000000.0;
+
+		std::string content = "{\"traceEvents\":[\n";
+
+		const int eventCount = capturedEvents_.size();
+
+		for (int i = 0; i < eventCount; i++)
+		{
+			const CapturedEvent& capturedEvent = capturedEvents_[i];
+			const Event& event = capturedEvent.ZoneEvent;
+
+			// Zones that started before the capture are clamped to its start
+			const Uint64 startCounter = event.StartCounter > captureStartCounter_ ? event.StartCounter : captureStartCounter_;
+			const Uint64 endCounter = event.EndCounter > startCounter ? event.EndCounter : startCounter;
+
+			char buffer[128];
+			SDL_snprintf(buffer, sizeof(buffer), "\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%lu}",
+				(startCounter - captureStartCounter_) / countsPerMicrosecond, (endCounter - startCounter) / countsPerMicrosecond, (unsigned long)capturedEvent.ThreadID);
+
+			content += "{\"name\":\"";
+			content += event.Name;
+			content += buffer;
+			content += i + 1 < eventCount ? ",\n" : "\n";
+		}
+
+		content += "]}\n";
+
+		capturedEvents_.clear();
+
+		SDL_RWops* file = SDL_RWFromFile(outputPath.c_str(), "w");
+
+		if (!file)
+		{
+			ErrorLogger::Get().LogSDLError("Profiler::EndCapture() - SDL_RWFromFile() failure");
+			return false;
+		}
+
+		const bool isWritten = SDL_RWwrite(file, content.c_str(), 1, content.size()) == content.size();
+		SDL_RWclose(file);
+
+		if (!isWritten)
+			ErrorLogger::Get().LogError("Profiler::EndCapture() failure", "Failed to write " + outputPath + "!");
+
+		return isWritten;
+	}
+
+	bool Profiler::IsCapturing() const
+	{
+		return isCapturing_;
+	}
+
+
+
+	Profiler::Profiler()
+	{
+		mutex_ = SDL_CreateMutex();
+
+		if (!mutex_)
+			ErrorLogger::Get().LogSDLError("Profiler::Profiler() - SDL_CreateMutex() failure");
+	}
+
+	Profiler::~Profiler()
+	{
+		SDL_DestroyMutex(mutex_);
+	}
+
+	Profiler::ThreadBuffer* Profiler::GetThreadBuffer()
+	{
+		thread_local ThreadBuffer* threadBuffer = nullptr;
+
+		if (threadBuffer || !mutex_) return threadBuffer;
+
+		// First zone of this thread: register a buffer. Buffers live as long as the Profiler, so zones of finished threads are still read.
+		std::unique_ptr<ThreadBuffer> newBuffer(new ThreadBuffer());
+		SDL_AtomicSet(&newBuffer->WriteCount, 0);
+		SDL_AtomicSet(&newBuffer->ReadCount, 0);
+		SDL_AtomicSet(&newBuffer->DroppedCount, 0);
+		newBuffer->ThreadID = SDL_ThreadID();
+
+		threadBuffer = newBuffer.get();
+
+		SDL_LockMutex(mutex_);
+		threadBuffers_.push_back(std::move(newBuffer));
+		SDL_UnlockMutex(mutex_);
+
+		return threadBuffer;
+	}
+
+
+
+	ProfileZone::ProfileZone(const char* name) :
+		name_(name),
+		startCounter_(SDL_GetPerformanceCounter())
+	{
+	}
+
+	ProfileZone::~ProfileZone()
+	{
+		Profiler::Get().RecordZone(name_, startCounter_, SDL_GetPerformanceCounter());
+	}
+
+}
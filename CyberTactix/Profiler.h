@@ -0,0 +1,146 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <SDL_mutex.h>
+#include <SDL_atomic.h>
+#include <SDL_thread.h>
+#include "Uncopyable.h"
+
+// Profiling is compiled out unless PIX_PROFILER is defined (e.g. in the project's preprocessor definitions).
+// Without PIX_PROFILER, the macros expand to nothing and cost nothing at runtime.
+//
+// PIX_PROFILE_ZONE(name): Measures the enclosing scope as a zone. name must be a string literal.
+// PIX_PROFILE_FRAME():    Ends the current frame; call once per frame on the main thread (GameLoop does this).
+#ifdef PIX_PROFILER
+#define PIX_PROFILE_CONCAT_INNER(a, b) a##b
+#define PIX_PROFILE_CONCAT(a, b) PIX_PROFILE_CONCAT_INNER(a, b)
+#define PIX_PROFILE_ZONE(name) pix::ProfileZone PIX_PROFILE_CONCAT(pixProfileZone, __LINE__)(name)
+#define PIX_PROFILE_FRAME() pix::Profiler::Get().EndFrame()
+#else
+#define PIX_PROFILE_ZONE(name)
+#define PIX_PROFILE_FRAME()
+#endif
+
+namespace pix
+{
+	// The Profiler singleton collects timed zones from all threads and aggregates them per frame.
+	//
+	// Technical note:
+	// Zones are timed with SDL_GetPerformanceCounter(). Each thread records finished zones into its own ring buffer
+	// without locking; only the first zone of a thread registers its buffer under a mutex.
+	// EndFrame() reads the new zones of all threads and aggregates them by name. If a thread records more than
+	// EVENT_CAPACITY zones between two EndFrame() calls, the newest zones are dropped and counted.
+	// During a capture, all zones are additionally kept and written as Chrome trace JSON (chrome://tracing, Perfetto),
+	// where nested zones show up as nested slices.
+	//
+	// Usage:
+	// void World::Update()
+	// {
+	//     PIX_PROFILE_ZONE("World::Update");
+	//     ...
+	// }
+	//
+	// Philosophy:
+	// Zone names are string literals and identify zones by address, so recording a zone never allocates.
+	class Profiler : private Uncopyable
+	{
+	public:
+
+		static constexpr int EVENT_CAPACITY = 16384; // Zones per thread and frame; must be a power of two
+
+		struct ZoneStatistics
+		{
+			const char* Name = nullptr;
+			double TotalMilliseconds = 0.0; // Summed over all calls and threads
+			double MaxMilliseconds = 0.0;   // Longest single call
+			int CallCount = 0;
+		};
+
+		// Returns the Profiler instance
+		static Profiler& Get();
+
+		// Records a finished zone of the calling thread. Called by ProfileZone.
+		void RecordZone(const char* name, Uint64 startCounter, Uint64 endCounter);
+
+		// Aggregates the zones recorded since the last call into the frame statistics. Must be called on the main thread.
+		void EndFrame();
+
+		// Returns the zone statistics of the last frame, in order of first appearance
+		const std::vector<ZoneStatistics>& GetFrameStatistics() const;
+
+		// Returns the time between the last two EndFrame() calls in milliseconds
+		double GetFrameMilliseconds() const;
+
+		// Returns the number of zones dropped because a ring buffer was full
+		int GetDroppedZoneCount() const;
+
+		// Starts keeping all zones for a Chrome trace. A running capture is restarted.
+		void BeginCapture();
+
+		// Ends the capture and writes it as Chrome trace JSON to outputPath.
+		// Returns true on success, false otherwise.
+		bool EndCapture(const std::string& outputPath);
+
+		bool IsCapturing() const;
+
+	private:
+
+		struct Event
+		{
+			const char* Name;
+			Uint64 StartCounter;
+			Uint64 EndCounter;
+		};
+
+		struct ThreadBuffer
+		{
+			Event Events[EVENT_CAPACITY];
+			SDL_atomic_t WriteCount;   // Zones written so far; published after the event is complete
+			SDL_atomic_t ReadCount;    // Zones consumed by EndFrame(); published after the events were read
+			SDL_atomic_t DroppedCount; // Zones dropped because the buffer was full
+			SDL_threadID ThreadID = 0;
+		};
+
+		struct CapturedEvent
+		{
+			Event ZoneEvent;
+			SDL_threadID ThreadID;
+		};
+
+		Profiler();
+		~Profiler();
+
+		// Returns the ring buffer of the calling thread, registering it on first use
+		ThreadBuffer* GetThreadBuffer();
+
+		SDL_mutex* mutex_ = nullptr; // Guards threadBuffers_
+		std::vector<std::unique_ptr<ThreadBuffer>> threadBuffers_;
+
+		// Main thread only
+		std::vector<ZoneStatistics> frameStatistics_;
+		std::unordered_map<const char*, int> statisticsIndices_;
+		std::vector<CapturedEvent> capturedEvents_;
+		Uint64 frameStartCounter_ = 0;
+		Uint64 captureStartCounter_ = 0;
+		double frameMilliseconds_ = 0.0;
+		int droppedZoneCount_ = 0;
+		bool isCapturing_ = false;
+	};
+
+	// ProfileZone measures its own lifetime as a zone. Use it through PIX_PROFILE_ZONE().
+	class ProfileZone : private Uncopyable
+	{
+	public:
+
+		explicit ProfileZone(const char* name);
+		~ProfileZone();
+
+	private:
+
+		const char* name_;
+		Uint64 startCounter_;
+	};
+}
@@ -0,0 +1,144 @@
+#include "RenderTargetPool.h"
+#include "ErrorLogger.h"
+
+namespace pix
+{
+
+	TargetTexture* RenderTargetPool::Acquire(int width, int height, bool isExactSize)
+	{
+		if (width <= 0 || height <= 0)
+		{
+			ErrorLogger::Get().LogError("RenderTargetPool::Acquire() failure", "width and height must be positive!");
+			return nullptr;
+		}
+
+		if (!isExactSize)
+		{
+			width = GetSizeClass(width);
+			height = GetSizeClass(height);
+		}
+
+		Bucket& bucket = buckets_[GetBucketKey(width, height)];
+
+		if (bucket.AcquiredCount == (int)bucket.Targets.size())
+		{
+			std::unique_ptr<TargetTexture> target(new TargetTexture());
+
+			if (!target->Realloc(width, height))
+				return nullptr;
+
+			bucket.Targets.push_back(std::move(target));
+
+			memoryUsage_ += (Sint64)width * height * 4;
+			if (memoryUsage_ > peakMemoryUsage_) peakMemoryUsage_ = memoryUsage_;
+
+			targetCount_++;
+			createdCount_++;
+		}
+
+		TargetTexture* target = bucket.Targets[bucket.AcquiredCount].get();
+		bucket.AcquiredCount++;
+		acquiredCount_++;
+
+		// Hand out a predictable blend state, whatever the previous user left behind
+		target->SetBlendMode(SDL_BLENDMODE_BLEND);
+		target->SetRGBAMod(255, 255, 255, 255);
+
+		return target;
+	}
+
+	void RenderTargetPool::RecycleAll()
+	{
+		for (auto& bucketEntry : buckets_)
+			bucketEntry.second.AcquiredCount = 0;
+
+		acquiredCount_ = 0;
+	}
+
+	int RenderTargetPool::ReleaseUnused()
+	{
+		int releasedCount = 0;
+
+		for (auto it = buckets_.begin(); it != buckets_.end();)
+		{
+			Bucket& bucket = it->second;
+			const int unusedCount = bucket.Targets.size() - bucket.AcquiredCount;
+
+			if (unusedCount > 0)
+			{
+				int width = 0, height = 0;
+				bucket.Targets.back()->GetSize(width, height);
+
+				memoryUsage_ -= (Sint64)width * height * 4 * unusedCount;
+				bucket.Targets.resize(bucket.AcquiredCount);
+
+				releasedCount += unusedCount;
+			}
+
+			if (bucket.Targets.empty())
+				it = buckets_.erase(it);
+			else
+				++it;
+		}
+
+		targetCount_ -= releasedCount;
+
+		return releasedCount;
+	}
+
+	void RenderTargetPool::Clear()
+	{
+		buckets_.clear();
+		memoryUsage_ = 0;
+		targetCount_ = 0;
+		acquiredCount_ = 0;
+	}
+
+	Sint64 RenderTargetPool::GetMemoryUsage() const
+	{
+		return memoryUsage_;
+	}
+
+	Sint64 RenderTargetPool::GetPeakMemoryUsage() const
+	{
+		return peakMemoryUsage_;
+	}
+
+	void RenderTargetPool::ResetPeakMemoryUsage()
+	{
+		peakMemoryUsage_ = memoryUsage_;
+	}
+
+	int RenderTargetPool::GetTargetCount() const
+	{
+		return targetCount_;
+	}
+
+	int RenderTargetPool::GetAcquiredCount() const
+	{
+		return acquiredCount_;
+	}
+
+	int RenderTargetPool::GetCreatedCount() const
+	{
+		return createdCount_;
+	}
+
+	int RenderTargetPool::GetSizeClass(int size)
+	{
+		int sizeClass = MIN_SIZE_CLASS;
+
+		while (sizeClass < size && sizeClass <= (SDL_MAX_SINT32 >> 1))
+			sizeClass <<= 1;
+
+		return sizeClass < size ? size : sizeClass;
+	}
+
+
+
+	Sint64 RenderTargetPool::GetBucketKey(int width, int height)
+	{
+		return ((Sint64)width << 32) | (Uint32)height;
+	}
+
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <SDL_stdinc.h>
+#include "Uncopyable.h"
+#include "TargetTexture.h"
+
+namespace pix
+{
+	// RenderTargetPool hands out temporary TargetTextures for the current frame and keeps them for reuse in later frames.
+	// Transient targets, e.g. for post-processing and UI composition, then only hit SDL_CreateTexture() while the pool warms up.
+	//
+	// Technical note:
+	// Targets are bucketed by size. By default, width and height are rounded up to size classes (powers of two, at least MIN_SIZE_CLASS),
+	// so that requests of slightly varying size share targets. The acquired target can therefore be larger than requested;
+	// render into its top-left width x height region and use that region as source rect. Request an exact size if the
+	// target must match, e.g. because a renderer maps the logical resolution onto the whole target.
+	// All TargetTextures share the RGBA32 format, so the size is the only bucket key.
+	// The memory of a target is estimated as width * height * 4 bytes.
+	//
+	// Usage:
+	// 1) TargetTexture* target = Renderer::Get().GetRenderTargetPool().Acquire(width, height);
+	// 2) Render into the target and use it during the current frame.
+	// 3) Renderer::SwapBuffers() returns all acquired targets to the pool.
+	//
+	// Philosophy:
+	// The pool owns its targets. An acquired target is valid until the end of the frame and must not be kept beyond it.
+	// Its content is undefined; its blend state is reset to SDL_BLENDMODE_BLEND with RGBA modulation 255, 255, 255, 255.
+	class RenderTargetPool : private Uncopyable
+	{
+	public:
+
+		static constexpr int MIN_SIZE_CLASS = 32;
+
+		RenderTargetPool() = default;
+		~RenderTargetPool() = default;
+
+		// Returns a target of at least width x height pixels that is not in use during the current frame.
+		// If isExactSize is true, the target is exactly width x height pixels.
+		// Returns nullptr if width or height is not positive or the target could not be created.
+		TargetTexture* Acquire(int width, int height, bool isExactSize = false);
+
+		// Returns all acquired targets to the pool. Called by Renderer::SwapBuffers().
+		void RecycleAll();
+
+		// Destroys all targets that are not acquired.
+		// Returns the number of destroyed targets.
+		int ReleaseUnused();
+
+		// Destroys all targets, including acquired ones. Called by Renderer::Destroy().
+		void Clear();
+
+		// Returns the estimated memory of all pooled targets in bytes
+		Sint64 GetMemoryUsage() const;
+
+		// Returns the highest memory usage since construction or the last ResetPeakMemoryUsage() call
+		Sint64 GetPeakMemoryUsage() const;
+
+		void ResetPeakMemoryUsage();
+
+		int GetTargetCount() const;
+
+		int GetAcquiredCount() const;
+
+		// Returns the number of targets created since construction; stays constant in steady state
+		int GetCreatedCount() const;
+
+		// Returns the size class of size: the next power of two, at least MIN_SIZE_CLASS
+		static int GetSizeClass(int size);
+
+	private:
+
+		struct Bucket
+		{
+			std::vector<std::unique_ptr<TargetTexture>> Targets; // The first AcquiredCount targets are in use
+			int AcquiredCount = 0;
+		};
+
+		static Sint64 GetBucketKey(int width, int height);
+
+		std::unordered_map<Sint64, Bucket> buckets_;
+		Sint64 memoryUsage_ = 0;
+		Sint64 peakMemoryUsage_ = 0;
+		int targetCount_ = 0;
+		int acquiredCount_ = 0;
+		int createdCount_ = 0;
+	};
+}
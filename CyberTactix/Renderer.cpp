@@ -17,31 +17,60 @@ namespace pix
 
 
 
-	bool Renderer::Init(int logicalResolutionWidth, int logicalResolutionHeight, bool isIntegerScale, bool isLinearFilter, bool vsync)
+	bool Renderer::Init(int logicalResolutionWidth, int logicalResolutionHeight, bool isIntegerScale, bool isLinearFilter, bool vsync, bool isHeadless)
 	{
 		if (isInitialized_) return true;
 
-		Uint32 flags = SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE;
-		if (vsync)
-			flags |= SDL_RENDERER_PRESENTVSYNC;
-
-		sdlRenderer_ = SDL_CreateRenderer(Window::Get().GetSDLWindow(), -1, flags); 
+		if (logicalResolutionWidth < 1) logicalResolutionWidth = 1;
+		if (logicalResolutionHeight < 1) logicalResolutionHeight = 1;
 
-		if (!sdlRenderer_)
+		if (isHeadless)
 		{
-			ErrorLogger::Get().LogSDLError("Renderer::Init() - SDL_CreateRenderer() failure");
+			vsync = false;
 
-			return false;
+			offscreenSurface_ = SDL_CreateRGBSurfaceWithFormat(0, logicalResolutionWidth, logicalResolutionHeight, 32, SDL_PIXELFORMAT_RGBA32);
+
+			if (!offscreenSurface_)
+			{
+				ErrorLogger::Get().LogSDLError("Renderer::Init() - SDL_CreateRGBSurfaceWithFormat() failure");
+				return false;
+			}
+
+			sdlRenderer_ = SDL_CreateSoftwareRenderer(offscreenSurface_);
+
+			if (!sdlRenderer_)
+			{
+				ErrorLogger::Get().LogSDLError("Renderer::Init() - SDL_CreateSoftwareRenderer() failure");
+
+				SDL_FreeSurface(offscreenSurface_);
+				offscreenSurface_ = nullptr;
+
+				return false;
+			}
 		}
+		else
+		{
+			Uint32 flags = SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE;
+			if (vsync)
+				flags |= SDL_RENDERER_PRESENTVSYNC;
 
-		if (logicalResolutionWidth < 1) logicalResolutionWidth = 1;
-		if (logicalResolutionHeight < 1) logicalResolutionHeight = 1;
+			sdlRenderer_ = SDL_CreateRenderer(Window::Get().GetSDLWindow(), -1, flags);
+
+			if (!sdlRenderer_)
+			{
+				ErrorLogger::Get().LogSDLError("Renderer::Init() - SDL_CreateRenderer() failure");
+
+				return false;
+			}
+		}
 
 		isVsync_ = vsync;
 
 		if (SDL_RenderSetLogicalSize(sdlRenderer_, logicalResolutionWidth, logicalResolutionHeight) != 0)
 			ErrorLogger::Get().LogSDLError("Renderer::Init() - SDL_RenderSetLogicalSize() failure");
 
+		SyncStateCache(); // The logical size changes the render scale
+
 		int w, h;
 		SDL_RenderGetLogicalSize(sdlRenderer_, &w, &h);
 		logicalResolutionWidth_ = w;
@@ -66,10 +95,20 @@ namespace pix
 	void Renderer::Destroy()
 	{
 		if (!sdlRenderer_) return;
+
+		renderTargetPool_.Clear(); // Pooled textures belong to this SDL_Renderer
 	
 		SDL_DestroyRenderer(sdlRenderer_);
+		SDL_FreeSurface(offscreenSurface_); // Ignores nullptr
 
 		sdlRenderer_ = nullptr;
+		offscreenSurface_ = nullptr;
+		renderTarget_ = nullptr;
+		renderTargetTexture_ = nullptr;
+		renderScale_ = Vec2f(1.0f, 1.0f);
+		renderColor_ = SDL_Color{ 0, 0, 0, 255 };
+		elidedCallCount_ = 0;
+		lastElidedCallCount_ = 0;
 		logicalResolutionWidth_ = 0.0f; 
 		logicalResolutionHeight_ = 0.0f;
 		isVsync_ = false;
@@ -102,7 +141,7 @@ namespace pix
 	{
 		if (SDL_RenderClear(sdlRenderer_) != 0)
 		{
-			ErrorLogger::Get().LogSDLError("Renderer::Clear() - SDL_RenderClear() failure");
+			ErrorLogger::Get().LogSDLError(PIX_ERROR_HANDLE("Renderer::Clear() - SDL_RenderClear() failure"));
 			return false;
 		}
 
@@ -114,34 +153,63 @@ namespace pix
 	{
 		SDL_Texture* sdlTexture = renderTarget ? renderTarget->GetSDLTexture() : nullptr;
 
+		if (sdlTexture == renderTarget_)
+		{
+			RecordElidedCall();
+			return true;
+		}
+
 		if (SDL_SetRenderTarget(sdlRenderer_, sdlTexture) != 0)
 		{
-			ErrorLogger::Get().LogSDLError("Renderer::SetRenderTarget() - SDL_SetRenderTarget() failure");
+			ErrorLogger::Get().LogSDLError(PIX_ERROR_HANDLE("Renderer::SetRenderTarget() - SDL_SetRenderTarget() failure"));
+			SyncStateCache();
 			return false;
 		}
 
+		renderTarget_ = sdlTexture;
+		renderTargetTexture_ = sdlTexture ? renderTarget : nullptr;
+
+		// SDL resets the render scale for texture targets and restores it for the default backbuffer
+		SDL_RenderGetScale(sdlRenderer_, &renderScale_.X, &renderScale_.Y);
+
 		return true;
 	}
 
 	bool Renderer::SetRenderColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a)
 	{
+		if (r == renderColor_.r && g == renderColor_.g && b == renderColor_.b && a == renderColor_.a)
+		{
+			RecordElidedCall();
+			return true;
+		}
+
 		if (SDL_SetRenderDrawColor(sdlRenderer_, r, g, b, a) != 0)
 		{
-			ErrorLogger::Get().LogSDLError("Renderer::SetRenderColor() - SDL_SetRenderDrawColor() failure");
+			ErrorLogger::Get().LogSDLError(PIX_ERROR_HANDLE("Renderer::SetRenderColor() - SDL_SetRenderDrawColor() failure"));
 			return false;
 		}
 
+		renderColor_ = SDL_Color{ r, g, b, a };
+
 		return true;
 	}
 
 	bool Renderer::SetRenderScale(float scaleX, float scaleY)
 	{
+		if (scaleX == renderScale_.X && scaleY == renderScale_.Y)
+		{
+			RecordElidedCall();
+			return true;
+		}
+
 		if (SDL_RenderSetScale(sdlRenderer_, scaleX, scaleY) != 0)
 		{
-			ErrorLogger::Get().LogSDLError("Renderer::SetRenderScale() - SDL_RenderSetScale() failure");
+			ErrorLogger::Get().LogSDLError(PIX_ERROR_HANDLE("Renderer::SetRenderScale() - SDL_RenderSetScale() failure"));
 			return false;
 		}
 
+		renderScale_ = Vec2f(scaleX, scaleY);
+
 		return true;
 	}
 
@@ -168,21 +236,53 @@ namespace pix
 			return false;
 		}
 
+		// Integer scaling recomputes the render scale of the logical size
+		SDL_RenderGetScale(sdlRenderer_, &renderScale_.X, &renderScale_.Y);
+
 		return true;
 	}
 
 	void Renderer::SwapBuffers()
 	{
 		SDL_RenderPresent(sdlRenderer_);
+
+		renderTargetPool_.RecycleAll();
+
+		lastElidedCallCount_ = elidedCallCount_;
+		elidedCallCount_ = 0;
+	}
+
+	void Renderer::SyncStateCache()
+	{
+		if (!sdlRenderer_) return;
+
+		SDL_Texture* sdlTexture = SDL_GetRenderTarget(sdlRenderer_);
+
+		if (sdlTexture != renderTarget_)
+		{
+			renderTarget_ = sdlTexture;
+			renderTargetTexture_ = nullptr; // Set outside of Renderer, the owner is unknown
+		}
+
+		SDL_RenderGetScale(sdlRenderer_, &renderScale_.X, &renderScale_.Y);
+
+		if (SDL_GetRenderDrawColor(sdlRenderer_, &renderColor_.r, &renderColor_.g, &renderColor_.b, &renderColor_.a) != 0)
+			ErrorLogger::Get().LogSDLError(PIX_ERROR_HANDLE("Renderer::SyncStateCache() - SDL_GetRenderDrawColor() failure"));
 	}
 	
 
 
 	void Renderer::GetRenderColor(Uint8& r, Uint8& g, Uint8& b, Uint8& a) const
 	{
-		if (SDL_GetRenderDrawColor(sdlRenderer_, &r, &g, &b, &a) != 0)
-			ErrorLogger::Get().LogSDLError("Renderer::GetRenderColor() - SDL_GetRenderDrawColor() failure");
+		r = renderColor_.r;
+		g = renderColor_.g;
+		b = renderColor_.b;
+		a = renderColor_.a;
+	}
 
+	TargetTexture* Renderer::GetRenderTarget() const
+	{
+		return renderTargetTexture_;
 	}
 
 	float Renderer::GetLogicalResolutionWidth() const
@@ -213,13 +313,29 @@ namespace pix
 		return isVsync_;
 	}
 
+	bool Renderer::IsHeadless() const
+	{
+		return offscreenSurface_ != nullptr;
+	}
+
+	SDL_Surface* Renderer::GetOffscreenSurface() const
+	{
+		return offscreenSurface_;
+	}
+
 	Vec2f Renderer::GetRenderScale() const
 	{
-		Vec2f scale;
+		return renderScale_;
+	}
 
-		SDL_RenderGetScale(sdlRenderer_, &scale.X, &scale.Y);
+	RenderTargetPool& Renderer::GetRenderTargetPool()
+	{
+		return renderTargetPool_;
+	}
 
-		return scale;
+	int Renderer::GetElidedCallCount() const
+	{
+		return lastElidedCallCount_;
 	}
 
 	SDL_Renderer* Renderer::GetSDLRenderer() const
@@ -239,4 +355,18 @@ namespace pix
 		Destroy();
 	}
 
+	void Renderer::RecordElidedCall()
+	{
+		elidedCallCount_++;
+	}
+
+	void Renderer::OnTextureDestroyed(SDL_Texture* sdlTexture)
+	{
+		if (!sdlRenderer_ || sdlTexture != renderTarget_) return;
+
+		renderTarget_ = nullptr;
+		renderTargetTexture_ = nullptr;
+		SDL_RenderGetScale(sdlRenderer_, &renderScale_.X, &renderScale_.Y);
+	}
+
 }
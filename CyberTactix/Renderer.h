@@ -3,6 +3,7 @@
 #include "Uncopyable.h"
 #include <SDL_render.h>
 #include "TargetTexture.h"
+#include "RenderTargetPool.h"
 #include "PixMath.h"
 
 namespace pix
@@ -17,6 +18,13 @@ namespace pix
 	// 
 	// Rendering is a critical subsystem; after Init() failure, normal engine execution should not continue.
 	// Rendering methods therefore assume successful initialization and do not perform repeated initialization checks.
+	//
+	// Technical note:
+	// Renderer shadows the current render target, render scale, and render color. Setters skip the SDL call
+	// if the requested state is already active, and getters return the shadowed state without querying SDL.
+	// Texture does the same for its blend mode and color modulation. Skipped calls are counted per frame (GetElidedCallCount()).
+	// SDL can change the render scale on its own, e.g. on window resize, so GameLoop re-reads the shadowed state once
+	// per frame before Render() (SyncStateCache()). Code that changes renderer state through the SDL_Renderer directly must do the same.
 	class Renderer : private Uncopyable
 	{
 	public:
@@ -32,9 +40,11 @@ namespace pix
 		// Calling Init() again after successful initialization has no effect and returns true.
         // Renderer setup failures after creation are logged but do not make Init() fail.
 		// Renderer is not meant to be reinitialized during normal program execution.
-		bool Init(int logicalResolutionWidth, int logicalResolutionHeight, bool isIntegerScale, bool isLinearFilter, bool vsync);
+		// If isHeadless is true, an SDL software renderer draws into an offscreen surface of the logical resolution instead of the window,
+		// and vsync is disabled. Headless rendering is deterministic and needs neither a display nor a GPU.
+		bool Init(int logicalResolutionWidth, int logicalResolutionHeight, bool isIntegerScale, bool isLinearFilter, bool vsync, bool isHeadless = false);
 
-		// Destroys the SDL_Renderer.
+		// Destroys the render target pool, the SDL_Renderer, and the offscreen surface in headless mode.
         // Destroy Texture subclasses before this, since they wrap SDL_Texture resources associated with this SDL_Renderer.
         // Must be called before destroying the Window to ensure proper cleanup order.
 		void Destroy();
@@ -72,12 +82,20 @@ namespace pix
 
 		bool SetIntegerScale(bool isIntegerScale);
 
+		// Presents the frame, returns all pooled render targets to the pool, and starts counting elided calls for the next frame
 		void SwapBuffers();
 
+		// Re-reads the shadowed render target, render scale, and render color from the SDL_Renderer
+		void SyncStateCache();
+
 		// ############################################################ GETTERS #######################################################################
 
 		void GetRenderColor(Uint8& r, Uint8& g, Uint8& b, Uint8& a) const;
 
+		// Returns the current render target, or nullptr for the default backbuffer.
+		// Also returns nullptr if the current target was set on the SDL_Renderer directly.
+		TargetTexture* GetRenderTarget() const;
+
 		float GetLogicalResolutionWidth() const;
 
 		float GetLogicalResolutionHeight() const;
@@ -89,14 +107,28 @@ namespace pix
 	    // Vsync can only be queried as it is only applied when the Renderer is created
 		bool IsVsync() const;
 
+		bool IsHeadless() const;
+
+		// Returns the surface rendered into in headless mode, e.g. to compare frames in regression tests.
+		// Returns nullptr if the Renderer is not headless. Ownership remains with Renderer.
+		SDL_Surface* GetOffscreenSurface() const;
+
 		Vec2f GetRenderScale() const;
 
+		// Returns the pool for temporary render targets that are valid until the end of the current frame
+		RenderTargetPool& GetRenderTargetPool();
+
+		// Returns the number of redundant SDL state calls that were skipped during the last frame
+		int GetElidedCallCount() const;
+
 		SDL_Renderer* GetSDLRenderer() const;
 
 		bool IsInitialized() const;
 
 	private:
 
+		friend class Texture; // Reports elided texture state calls and texture destruction
+
 		Renderer() = default;
 
 		// Final safety cleanup.
@@ -104,7 +136,20 @@ namespace pix
         // (Texture subclasses before Renderer, Renderer before Window).
 		~Renderer();
 
+		void RecordElidedCall();
+
+		// Forgets sdlTexture as render target. SDL falls back to the default backbuffer when the current target is destroyed.
+		void OnTextureDestroyed(SDL_Texture* sdlTexture);
+
 		SDL_Renderer* sdlRenderer_ = nullptr;
+		SDL_Surface* offscreenSurface_ = nullptr; // Headless mode only
+		RenderTargetPool renderTargetPool_;
+		SDL_Texture* renderTarget_ = nullptr;      // Shadowed state
+		TargetTexture* renderTargetTexture_ = nullptr; // Owner of renderTarget_, if set through SetRenderTarget()
+		Vec2f renderScale_ = Vec2f(1.0f, 1.0f);    // Shadowed state
+		SDL_Color renderColor_ = { 0, 0, 0, 255 }; // Shadowed state
+		int elidedCallCount_ = 0;      // Current frame
+		int lastElidedCallCount_ = 0;  // Last completed frame
 		float logicalResolutionWidth_ = 0.0f;
 		float logicalResolutionHeight_ = 0.0f;
 		bool isVsync_ = true;
@@ -0,0 +1,560 @@
+#include "RendererBenchmark.h"
+#include <memory>
+#include <algorithm>
+#include <SDL_timer.h>
+#include <SDL_rwops.h>
+#include "Renderer.h"
+#include "ErrorLogger.h"
+#include "SpriteMeshOps.h"
+#include "SpriteMeshRenderer2D.h"
+#include "SpriteMeshRenderer3D.h"
+#include "TriangleMesh2DRenderer2D.h"
+#include "TriangleMeshRenderer3D.h"
+
+namespace pix
+{
+	namespace
+	{
+		constexpr float OBJECT_SIZE = 8.0f;
+		constexpr float NEAR_DEPTH = 20.0f; // 3D objects are spread in depth between NEAR_DEPTH and FAR_DEPTH in front of the camera
+		constexpr float FAR_DEPTH = 60.0f;
+
+		// Deterministic spread of object i over [0, range)
+		float GetSpread(int i, int prime, float range)
+		{
+			return (float)((i * prime) % 1009) / 1009.0f * range;
+		}
+
+		Vec2 GetPosition2D(int i)
+		{
+			const Renderer& renderer = Renderer::Get();
+			return Vec2(GetSpread(i, 37, renderer.GetLogicalResolutionWidth()), GetSpread(i, 71, renderer.GetLogicalResolutionHeight()));
+		}
+
+		Vec3 GetPosition3D(int i)
+		{
+			return Vec3(GetSpread(i, 37, 40.0f) - 20.0f, GetSpread(i, 71, 24.0f) - 12.0f, -NEAR_DEPTH - GetSpread(i, 13, FAR_DEPTH - NEAR_DEPTH));
+		}
+
+		// A child is placed relative to its parent; a uniform scale keeps the chains valid for RenderFast()
+		const Vec2 CHILD_OFFSET_2D = Vec2(OBJECT_SIZE, 0.0);
+		const Vec3 CHILD_OFFSET_3D = Vec3(1.0, 0.0, 0.0);
+
+		// Creates count nodes that form chains of depth nodes each. createNode(i, isRoot) returns a new node.
+		template<typename Node, typename CreateNodeFunction>
+		std::vector<std::unique_ptr<Node>> GetNodeChains(int count, int depth, CreateNodeFunction createNode)
+		{
+			std::vector<std::unique_ptr<Node>> nodes;
+			nodes.reserve(count);
+
+			for (int i = 0; i < count; i++)
+			{
+				const bool isRoot = i % depth == 0;
+				nodes.emplace_back(createNode(i, isRoot));
+
+				if (!isRoot)
+					nodes[i]->SetParent(nodes[i - 1].get());
+			}
+
+			return nodes;
+		}
+
+		TriangleMesh2D GetQuadTriangleMesh2D()
+		{
+			const float halfSize = OBJECT_SIZE * 0.5f;
+			const SDL_Color white = { 255, 255, 255, 255 };
+			const Vec3f normal(0.0f, 0.0f, 1.0f);
+
+			const Vertex2DEx topLeft(Vec2f(-halfSize, halfSize), white, Vec2f(0.0f, 0.0f), normal);
+			const Vertex2DEx topRight(Vec2f(halfSize, halfSize), white, Vec2f(1.0f, 0.0f), normal);
+			const Vertex2DEx bottomRight(Vec2f(halfSize, -halfSize), white, Vec2f(1.0f, 1.0f), normal);
+			const Vertex2DEx bottomLeft(Vec2f(-halfSize, -halfSize), white, Vec2f(0.0f, 1.0f), normal);
+
+			return TriangleMesh2D({ topLeft, topRight, bottomRight, bottomRight, bottomLeft, topLeft });
+		}
+
+		TriangleMesh3D GetQuadTriangleMesh3D()
+		{
+			const SDL_Color white = { 255, 255, 255, 255 };
+			const Vec3f normal(0.0f, 0.0f, 1.0f);
+
+			const Vertex3D topLeft(Vec3f(-0.5f, 0.5f, 0.0f), white, Vec2f(0.0f, 0.0f), normal);
+			const Vertex3D topRight(Vec3f(0.5f, 0.5f, 0.0f), white, Vec2f(1.0f, 0.0f), normal);
+			const Vertex3D bottomRight(Vec3f(0.5f, -0.5f, 0.0f), white, Vec2f(1.0f, 1.0f), normal);
+			const Vertex3D bottomLeft(Vec3f(-0.5f, -0.5f, 0.0f), white, Vec2f(0.0f, 1.0f), normal);
+
+			return TriangleMesh3D({ topLeft, topRight, bottomRight, bottomRight, bottomLeft, topLeft });
+		}
+
+		// Formats a double without locale dependence
+		std::string GetNumberString(double value)
+		{
+			char buffer[64];
+			SDL_snprintf(buffer, sizeof(buffer), "%.6g", value);
+			return buffer;
+		}
+	}
+
+
+
+	bool RendererBenchmark::Run(const Settings& settings)
+	{
+		results_.clear();
+
+		if (!Renderer::Get().IsInitialized())
+		{
+			ErrorLogger::Get().LogError("RendererBenchmark::Run() failure", "Renderer is not initialized!");
+			return false;
+		}
+
+		if (!texture_.IsInitialized())
+		{
+			if (!texture_.Realloc(16, 16)) return false;
+
+			Renderer& renderer = Renderer::Get();
+			renderer.SetRenderTarget(&texture_);
+			renderer.SetRenderColor(255, 255, 255, 255);
+			renderer.Clear();
+			renderer.SetRenderColor(0, 0, 0, 255);
+			renderer.SetRenderTarget(nullptr);
+		}
+
+		RunSpriteMeshRenderer2D(settings);
+		RunSpriteMeshRenderer3D(settings);
+		RunTriangleMesh2DRenderer2D(settings);
+		RunTriangleMeshRenderer3D(settings);
+
+		return true;
+	}
+
+	const std::vector<RendererBenchmark::Result>& RendererBenchmark::GetResults() const
+	{
+		return results_;
+	}
+
+	bool RendererBenchmark::WriteCSV(const std::string& outputPath) const
+	{
+		std::string content = "Renderer,Path,ObjectCount,HierarchyDepth,VertexCount,MeanMilliseconds,MinMilliseconds,NanosecondsPerObject,VerticesPerSecond\n";
+
+		for (const Result& result : results_)
+		{
+			content += result.RendererName + "," + result.PathName + "," + std::to_string(result.ObjectCount) + "," + std::to_string(result.HierarchyDepth) + ","
+				+ std::to_string(result.VertexCount) + "," + GetNumberString(result.MeanMilliseconds) + "," + GetNumberString(result.MinMilliseconds) + ","
+				+ GetNumberString(result.NanosecondsPerObject) + "," + GetNumberString(result.VerticesPerSecond) + "\n";
+		}
+
+		return WriteFile(outputPath, content);
+	}
+
+	bool RendererBenchmark::WriteJSON(const std::string& outputPath) const
+	{
+		std::string content = "[\n";
+
+		const int resultCount = results_.size();
+
+		for (int i = 0; i < resultCount; i++)
+		{
+			const Result& result = results_[i];
+
+			content += "  { \"renderer\": \"" + result.RendererName + "\", \"path\": \"" + result.PathName + "\", \"objectCount\": " + std::to_string(result.ObjectCount)
+				+ ", \"hierarchyDepth\": " + std::to_string(result.HierarchyDepth) + ", \"vertexCount\": " + std::to_string(result.VertexCount)
+				+ ", \"meanMilliseconds\": " + GetNumberString(result.MeanMilliseconds) + ", \"minMilliseconds\": " + GetNumberString(result.MinMilliseconds)
+				+ ", \"nanosecondsPerObject\": " + GetNumberString(result.NanosecondsPerObject) + ", \"verticesPerSecond\": " + GetNumberString(result.VerticesPerSecond) + " }";
+
+			content += i + 1 < resultCount ? ",\n" : "\n";
+		}
+
+		content += "]\n";
+
+		return WriteFile(outputPath, content);
+	}
+
+
+
+	void RendererBenchmark::RunSpriteMeshRenderer2D(const Settings& settings)
+	{
+		const char* rendererName = "SpriteMeshRenderer2D";
+		const float halfSize = OBJECT_SIZE * 0.5f;
+		const SpriteMesh mesh = GetSpriteMesh(Vec2f(-halfSize, halfSize), Vec2f(halfSize, -halfSize));
+
+		const MovableObject2D camera;
+		const Vec2f renderTargetOffset(0.0f, Renderer::Get().GetLogicalResolutionHeight());
+
+		for (int objectCount : settings.BatchSizes)
+		{
+			if (objectCount <= 0) continue;
+
+			SpriteMeshRenderer2D spriteRenderer(objectCount * SpriteMesh::VERTEX_COUNT);
+
+			auto runBatch = [&](auto submit)
+			{
+				return [&, submit]()
+				{
+					spriteRenderer.BeginBatch(camera, renderTargetOffset);
+					submit();
+					spriteRenderer.RenderBatch(texture_, nullptr);
+				};
+			};
+
+			std::vector<Transform2D> transforms;
+			std::vector<Sprite2D> sprites;
+
+			for (int i = 0; i < objectCount; i++)
+			{
+				transforms.push_back(Transform2D(GetPosition2D(i), Vec2f(1.0f, 1.0f), Rotation2D((float)(i % 360))));
+				sprites.push_back(Sprite2D(&mesh, transforms[i]));
+			}
+
+			Measure(settings, rendererName, "Transform", objectCount, 1, SpriteMesh::VERTEX_COUNT, runBatch([&]()
+			{
+				for (int i = 0; i < objectCount; i++) spriteRenderer.Render(mesh, transforms[i]);
+			}));
+
+			Measure(settings, rendererName, "Sprite", objectCount, 1, SpriteMesh::VERTEX_COUNT, runBatch([&]()
+			{
+				for (int i = 0; i < objectCount; i++) spriteRenderer.Render(sprites[i]);
+			}));
+
+			Measure(settings, rendererName, "Line", objectCount, 1, SpriteMesh::VERTEX_COUNT, runBatch([&]()
+			{
+				for (int i = 0; i < objectCount; i++) spriteRenderer.RenderLine(mesh, transforms[i].Position, transforms[i].Position + Vec2(20.0, 10.0), 2.0f);
+			}));
+
+			Measure(settings, rendererName, "Point", objectCount, 1, SpriteMesh::VERTEX_COUNT, runBatch([&]()
+			{
+				for (int i = 0; i < objectCount; i++) spriteRenderer.RenderPoint(mesh, transforms[i].Position, 4.0f);
+			}));
+
+			Measure(settings, rendererName, "Pixel", objectCount, 1, SpriteMesh::VERTEX_COUNT, runBatch([&]()
+			{
+				for (int i = 0; i < objectCount; i++) spriteRenderer.RenderPixel(mesh, Vec2f((float)transforms[i].Position.X, (float)transforms[i].Position.Y), 2.0f);
+			}));
+
+			Measure(settings, rendererName, "PixelLine", objectCount, 1, SpriteMesh::VERTEX_COUNT, runBatch([&]()
+			{
+				for (int i = 0; i < objectCount; i++)
+				{
+					const Vec2f position((float)transforms[i].Position.X, (float)transforms[i].Position.Y);
+					spriteRenderer.RenderPixelLine(mesh, position, position + Vec2f(20.0f, 10.0f), 2.0f);
+				}
+			}));
+
+			Measure(settings, rendererName, "HorizontalPixelLine", objectCount, 1, SpriteMesh::VERTEX_COUNT, runBatch([&]()
+			{
+				for (int i = 0; i < objectCount; i++) spriteRenderer.RenderHorizontalPixelLine(mesh, Vec2f((float)transforms[i].Position.X, (float)transforms[i].Position.Y), 20.0f, 2.0f);
+			}));
+
+			Measure(settings, rendererName, "VerticalPixelLine", objectCount, 1, SpriteMesh::VERTEX_COUNT, runBatch([&]()
+			{
+				for (int i = 0; i < objectCount; i++) spriteRenderer.RenderVerticalPixelLine(mesh, Vec2f((float)transforms[i].Position.X, (float)transforms[i].Position.Y), 20.0f, 2.0f);
+			}));
+
+			Measure(settings, rendererName, "PixelMesh", objectCount, 1, SpriteMesh::VERTEX_COUNT, runBatch([&]()
+			{
+				for (int i = 0; i < objectCount; i++) spriteRenderer.RenderPixelMesh(mesh, Vec2f((float)transforms[i].Position.X, (float)transforms[i].Position.Y));
+			}));
+
+			for (int depth : settings.HierarchyDepths)
+			{
+				if (depth <= 0) continue;
+
+				std::vector<std::unique_ptr<Sprite2DNode>> nodes = GetNodeChains<Sprite2DNode>(objectCount, depth, [&](int i, bool isRoot)
+				{
+					return new Sprite2DNode(&mesh, isRoot ? GetPosition2D(i) : CHILD_OFFSET_2D, Vec2f(1.0f, 1.0f), Rotation2D(5.0f));
+				});
+
+				Measure(settings, rendererName, "Node", objectCount, depth, SpriteMesh::VERTEX_COUNT, runBatch([&]()
+				{
+					for (int i = 0; i < objectCount; i++) spriteRenderer.Render(*nodes[i]);
+				}));
+
+				Measure(settings, rendererName, "RenderFast", objectCount, depth, SpriteMesh::VERTEX_COUNT, runBatch([&]()
+				{
+					for (int i = 0; i < objectCount; i++) spriteRenderer.RenderFast(*nodes[i]);
+				}));
+			}
+		}
+	}
+
+	void RendererBenchmark::RunSpriteMeshRenderer3D(const Settings& settings)
+	{
+		const char* rendererName = "SpriteMeshRenderer3D";
+		const SpriteMesh mesh = GetSpriteMesh(Vec2f(-0.5f, 0.5f), Vec2f(0.5f, -0.5f));
+
+		const MovableObject3D camera;
+		const Vec2f renderTargetOffset(Renderer::Get().GetLogicalResolutionWidth() * 0.5f, Renderer::Get().GetLogicalResolutionHeight() * 0.5f);
+
+		for (int objectCount : settings.BatchSizes)
+		{
+			if (objectCount <= 0) continue;
+
+			SpriteMeshRenderer3D spriteRenderer(objectCount * SpriteMesh::VERTEX_COUNT);
+
+			auto runBatch = [&](auto submit)
+			{
+				return [&, submit]()
+				{
+					spriteRenderer.BeginBatch(camera, renderTargetOffset);
+					submit();
+					spriteRenderer.RenderBatch(texture_, nullptr);
+				};
+			};
+
+			std::vector<Transform3D> transforms;
+			std::vector<Sprite3D> sprites;
+
+			for (int i = 0; i < objectCount; i++)
+			{
+				transforms.push_back(Transform3D(GetPosition3D(i)));
+				sprites.push_back(Sprite3D(&mesh, transforms[i]));
+			}
+
+			Measure(settings, rendererName, "Transform", objectCount, 1, SpriteMesh::VERTEX_COUNT, runBatch([&]()
+			{
+				for (int i = 0; i < objectCount; i++) spriteRenderer.Render(mesh, transforms[i]);
+			}));
+
+			Measure(settings, rendererName, "Sprite", objectCount, 1, SpriteMesh::VERTEX_COUNT, runBatch([&]()
+			{
+				for (int i = 0; i < objectCount; i++) spriteRenderer.Render(sprites[i]);
+			}));
+
+			Measure(settings, rendererName, "Line", objectCount, 1, SpriteMesh::VERTEX_COUNT, runBatch([&]()
+			{
+				for (int i = 0; i < objectCount; i++) spriteRenderer.RenderLine(mesh, transforms[i].Position, transforms[i].Position + Vec3(2.0, 1.0, 0.0), 2.0f);
+			}));
+
+			Measure(settings, rendererName, "Point", objectCount, 1, SpriteMesh::VERTEX_COUNT, runBatch([&]()
+			{
+				for (int i = 0; i < objectCount; i++) spriteRenderer.RenderPoint(mesh, transforms[i].Position, 4.0f);
+			}));
+
+			for (int depth : settings.HierarchyDepths)
+			{
+				if (depth <= 0) continue;
+
+				std::vector<std::unique_ptr<Sprite3DNode>> nodes = GetNodeChains<Sprite3DNode>(objectCount, depth, [&](int i, bool isRoot)
+				{
+					return new Sprite3DNode(&mesh, isRoot ? GetPosition3D(i) : CHILD_OFFSET_3D);
+				});
+
+				Measure(settings, rendererName, "Node", objectCount, depth, SpriteMesh::VERTEX_COUNT, runBatch([&]()
+				{
+					for (int i = 0; i < objectCount; i++) spriteRenderer.Render(*nodes[i]);
+				}));
+
+				Measure(settings, rendererName, "RenderFast", objectCount, depth, SpriteMesh::VERTEX_COUNT, runBatch([&]()
+				{
+					for (int i = 0; i < objectCount; i++) spriteRenderer.RenderFast(*nodes[i]);
+				}));
+			}
+		}
+	}
+
+	void RendererBenchmark::RunTriangleMesh2DRenderer2D(const Settings& settings)
+	{
+		const char* rendererName = "TriangleMesh2DRenderer2D";
+		const TriangleMesh2D mesh = GetQuadTriangleMesh2D();
+		const int verticesPerObject = mesh.Vertices.size();
+
+		const MovableObject2D camera;
+		const Vec2f renderTargetOffset(0.0f, Renderer::Get().GetLogicalResolutionHeight());
+
+		for (int objectCount : settings.BatchSizes)
+		{
+			if (objectCount <= 0) continue;
+
+			TriangleMesh2DRenderer2D meshRenderer(objectCount * verticesPerObject);
+
+			auto runBatch = [&](auto submit)
+			{
+				return [&, submit]()
+				{
+					meshRenderer.BeginBatch(camera, renderTargetOffset);
+					submit();
+					meshRenderer.RenderBatch(texture_, nullptr);
+				};
+			};
+
+			std::vector<Transform2D> transforms;
+			std::vector<Sprite2DEx> sprites;
+
+			for (int i = 0; i < objectCount; i++)
+			{
+				transforms.push_back(Transform2D(GetPosition2D(i), Vec2f(1.0f, 1.0f), Rotation2D((float)(i % 360))));
+				sprites.push_back(Sprite2DEx(&mesh, transforms[i]));
+			}
+
+			Measure(settings, rendererName, "Transform", objectCount, 1, verticesPerObject, runBatch([&]()
+			{
+				for (int i = 0; i < objectCount; i++) meshRenderer.Render(mesh, transforms[i]);
+			}));
+
+			Measure(settings, rendererName, "Sprite", objectCount, 1, verticesPerObject, runBatch([&]()
+			{
+				for (int i = 0; i < objectCount; i++) meshRenderer.Render(sprites[i]);
+			}));
+
+			for (int depth : settings.HierarchyDepths)
+			{
+				if (depth <= 0) continue;
+
+				std::vector<std::unique_ptr<Sprite2DExNode>> nodes = GetNodeChains<Sprite2DExNode>(objectCount, depth, [&](int i, bool isRoot)
+				{
+					return new Sprite2DExNode(&mesh, isRoot ? GetPosition2D(i) : CHILD_OFFSET_2D, Vec2f(1.0f, 1.0f), Rotation2D(5.0f));
+				});
+
+				Measure(settings, rendererName, "Node", objectCount, depth, verticesPerObject, runBatch([&]()
+				{
+					for (int i = 0; i < objectCount; i++) meshRenderer.Render(*nodes[i]);
+				}));
+
+				Measure(settings, rendererName, "RenderFast", objectCount, depth, verticesPerObject, runBatch([&]()
+				{
+					for (int i = 0; i < objectCount; i++) meshRenderer.RenderFast(*nodes[i]);
+				}));
+			}
+		}
+	}
+
+	void RendererBenchmark::RunTriangleMeshRenderer3D(const Settings& settings)
+	{
+		const char* rendererName = "TriangleMeshRenderer3D";
+		const TriangleMesh3D mesh3D = GetQuadTriangleMesh3D();
+		const TriangleMesh2D mesh2D = GetQuadTriangleMesh2D();
+		const int verticesPerObject = mesh3D.Vertices.size();
+
+		const MovableObject3D camera;
+		const Vec2f renderTargetOffset(Renderer::Get().GetLogicalResolutionWidth() * 0.5f, Renderer::Get().GetLogicalResolutionHeight() * 0.5f);
+
+		// The 2D quad mesh is OBJECT_SIZE units wide; scale it down to the size of the 3D quad
+		const Vec3f meshScale2D(1.0f / OBJECT_SIZE, 1.0f / OBJECT_SIZE, 1.0f);
+
+		for (int objectCount : settings.BatchSizes)
+		{
+			if (objectCount <= 0) continue;
+
+			TriangleMeshRenderer3D meshRenderer(objectCount * verticesPerObject);
+
+			auto runBatch = [&](auto submit)
+			{
+				return [&, submit]()
+				{
+					meshRenderer.BeginBatch(camera, renderTargetOffset);
+					submit();
+					meshRenderer.RenderBatch(texture_, nullptr);
+				};
+			};
+
+			std::vector<Transform3D> transforms;
+			std::vector<Transform3D> transforms2D;
+			std::vector<Sprite3DEx> sprites;
+
+			for (int i = 0; i < objectCount; i++)
+			{
+				transforms.push_back(Transform3D(GetPosition3D(i)));
+				transforms2D.push_back(Transform3D(GetPosition3D(i), meshScale2D));
+				sprites.push_back(Sprite3DEx(&mesh2D, transforms2D[i]));
+			}
+
+			Measure(settings, rendererName, "Transform", objectCount, 1, verticesPerObject, runBatch([&]()
+			{
+				for (int i = 0; i < objectCount; i++) meshRenderer.Render(mesh3D, transforms[i]);
+			}));
+
+			Measure(settings, rendererName, "Transform2DMesh", objectCount, 1, verticesPerObject, runBatch([&]()
+			{
+				for (int i = 0; i < objectCount; i++) meshRenderer.Render(mesh2D, transforms2D[i]);
+			}));
+
+			Measure(settings, rendererName, "Sprite", objectCount, 1, verticesPerObject, runBatch([&]()
+			{
+				for (int i = 0; i < objectCount; i++) meshRenderer.Render(sprites[i]);
+			}));
+
+			for (int depth : settings.HierarchyDepths)
+			{
+				if (depth <= 0) continue;
+
+				std::vector<std::unique_ptr<Sprite3DExNode>> nodes = GetNodeChains<Sprite3DExNode>(objectCount, depth, [&](int i, bool isRoot)
+				{
+					return isRoot ? new Sprite3DExNode(&mesh2D, GetPosition3D(i), meshScale2D) : new Sprite3DExNode(&mesh2D, CHILD_OFFSET_3D);
+				});
+
+				Measure(settings, rendererName, "Node", objectCount, depth, verticesPerObject, runBatch([&]()
+				{
+					for (int i = 0; i < objectCount; i++) meshRenderer.Render(*nodes[i]);
+				}));
+
+				Measure(settings, rendererName, "RenderFast", objectCount, depth, verticesPerObject, runBatch([&]()
+				{
+					for (int i = 0; i < objectCount; i++) meshRenderer.RenderFast(*nodes[i]);
+				}));
+			}
+		}
+	}
+
+	template<typename IterationFunction>
+	void RendererBenchmark::Measure(const Settings& settings, const char* rendererName, const char* pathName, int objectCount, int hierarchyDepth, int verticesPerObject, IterationFunction iteration)
+	{
+		SDL_Renderer* sdlRenderer = Renderer::Get().GetSDLRenderer();
+
+		for (int i = 0; i < settings.WarmupIterationCount; i++)
+		{
+			iteration();
+			SDL_RenderFlush(sdlRenderer);
+		}
+
+		const int iterationCount = std::max(settings.IterationCount, 1);
+		const double countsPerMillisecond = SDL_GetPerformanceFrequency() / 1000.0;
+
+		double totalMilliseconds = 0.0;
+		double minMilliseconds = 0.0;
+
+		for (int i = 0; i < iterationCount; i++)
+		{
+			const Uint64 startCounter = SDL_GetPerformanceCounter();
+
+			iteration();
+			SDL_RenderFlush(sdlRenderer); // SDL queues render commands; include their execution
+
+			const double milliseconds = (SDL_GetPerformanceCounter() - startCounter) / countsPerMillisecond;
+
+			totalMilliseconds += milliseconds;
+			if (i == 0 || milliseconds < minMilliseconds) minMilliseconds = milliseconds;
+		}
+
+		Result result;
+		result.RendererName = rendererName;
+		result.PathName = pathName;
+		result.ObjectCount = objectCount;
+		result.HierarchyDepth = hierarchyDepth;
+		result.VertexCount = objectCount * verticesPerObject;
+		result.MeanMilliseconds = totalMilliseconds / iterationCount;
+		result.MinMilliseconds = minMilliseconds;
+		result.NanosecondsPerObject = result.MeanMilliseconds * 1000000.0 / objectCount;
+		result.VerticesPerSecond = result.MeanMilliseconds > 0.0 ? result.VertexCount / (result.MeanMilliseconds / 1000.0) : 0.0;
+
+		results_.push_back(result);
+	}
+
+	bool RendererBenchmark::WriteFile(const std::string& outputPath, const std::string& content)
+	{
+		SDL_RWops* file = SDL_RWFromFile(outputPath.c_str(), "w");
+
+		if (!file)
+		{
+			ErrorLogger::Get().LogSDLError("RendererBenchmark::WriteFile() - SDL_RWFromFile() failure");
+			return false;
+		}
+
+		const bool isWritten = SDL_RWwrite(file, content.c_str(), 1, content.size()) == content.size();
+		SDL_RWclose(file);
+
+		if (!isWritten)
+			ErrorLogger::Get().LogError("RendererBenchmark::WriteFile() failure", "Failed to write " + outputPath + "!");
+
+		return isWritten;
+	}
+
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "Uncopyable.h"
+#include "TargetTexture.h"
+
+namespace pix
+{
+	// RendererBenchmark measures the render paths of SpriteMeshRenderer2D, SpriteMeshRenderer3D, TriangleMesh2DRenderer2D,
+	// and TriangleMeshRenderer3D, and writes the results as CSV or JSON to track performance regressions.
+	//
+	// Technical note:
+	// Each measured iteration submits one batch via BeginBatch(), the render path under test, and RenderBatch(),
+	// followed by SDL_RenderFlush(), so that the rasterization SDL queues internally is included in the timing.
+	// Node paths (Render(node), RenderFast(node)) are measured for each hierarchy depth: the objects form chains of that depth.
+	// Results are most comparable with the headless software renderer (LaunchConfigData::IsHeadless),
+	// which runs without vsync, display, or GPU and therefore measures the same work on every machine.
+	//
+	// Usage:
+	// 1) Initialize the Renderer, preferably headless.
+	// 2) benchmark.Run(RendererBenchmark::Settings());
+	// 3) benchmark.WriteCSV("RendererBenchmark.csv"); benchmark.WriteJSON("RendererBenchmark.json");
+	//
+	// Philosophy:
+	// The benchmark is part of the library, so games can run it on their target machines, e.g. behind a command line switch.
+	class RendererBenchmark : private Uncopyable
+	{
+	public:
+
+		struct Settings
+		{
+			std::vector<int> BatchSizes = { 100, 1000, 10000 }; // Objects per batch
+			std::vector<int> HierarchyDepths = { 1, 4, 16 };    // Node chain lengths for the node paths
+			int IterationCount = 30;
+			int WarmupIterationCount = 5;                       // Iterations run before measuring, not included in the results
+		};
+
+		struct Result
+		{
+			std::string RendererName;
+			std::string PathName;
+			int ObjectCount = 0;
+			int HierarchyDepth = 1;           // 1 for paths without hierarchy
+			int VertexCount = 0;              // Vertices per batch
+			double MeanMilliseconds = 0.0;    // Per batch
+			double MinMilliseconds = 0.0;     // Per batch
+			double NanosecondsPerObject = 0.0; // Based on the mean
+			double VerticesPerSecond = 0.0;    // Based on the mean
+		};
+
+		RendererBenchmark() = default;
+		~RendererBenchmark() = default;
+
+		// Runs all render paths with all batch sizes (and hierarchy depths for node paths) and replaces the previous results.
+		// Requires an initialized Renderer. Renders to the default back buffer.
+		// Returns false if the benchmark could not be set up.
+		bool Run(const Settings& settings);
+
+		const std::vector<Result>& GetResults() const;
+
+		// Writes the results with a header line. Returns true on success, false otherwise.
+		bool WriteCSV(const std::string& outputPath) const;
+
+		// Writes the results as a JSON array of objects. Returns true on success, false otherwise.
+		bool WriteJSON(const std::string& outputPath) const;
+
+	private:
+
+		void RunSpriteMeshRenderer2D(const Settings& settings);
+		void RunSpriteMeshRenderer3D(const Settings& settings);
+		void RunTriangleMesh2DRenderer2D(const Settings& settings);
+		void RunTriangleMeshRenderer3D(const Settings& settings);
+
+		// Runs iteration (one complete batch) settings.IterationCount times after warming up and appends the timing as a result
+		template<typename IterationFunction>
+		void Measure(const Settings& settings, const char* rendererName, const char* pathName, int objectCount, int hierarchyDepth, int verticesPerObject, IterationFunction iteration);
+
+		static bool WriteFile(const std::string& outputPath, const std::string& content);
+
+		std::vector<Result> results_;
+		TargetTexture texture_; // Small white texture shared by all paths
+	};
+}
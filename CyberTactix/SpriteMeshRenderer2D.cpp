@@ -355,6 +355,18 @@ namespace pix
 		vertexBatch_.emplace_back(quadPoint, vertices[3].Color, vertices[3].UV);
 	}
 
+	void SpriteMeshRenderer2D::RenderPixelMesh(const SpriteMesh& mesh, Vec2f position, float scale)
+	{
+		const Vertex2D* const vertices = mesh.Vertices;
+
+		for (int i = 0; i < 4; i++)
+		{
+			const Vec2f vertexPosition(position.X + vertices[i].Position.X * scale, position.Y + vertices[i].Position.Y * scale);
+
+			vertexBatch_.emplace_back(vertexPosition, vertices[i].Color, vertices[i].UV);
+		}
+	}
+
 	void SpriteMeshRenderer2D::BeginBatch(const MovableObject2D& camera, Vec2f renderTargetOffset, float interpolationAlpha)
 	{
 		vertexBatch_.clear();
@@ -106,6 +106,12 @@ namespace pix
 		// Low-overhead: operates directly in render-target space and does not apply the camera transform.
 		void RenderVerticalPixelLine(const SpriteMesh& mesh, Vec2f startPosition, float length, float lineWidth = 1.0f);
 
+		// Renders a SpriteMesh in logical render-target space without applying the camera transform.
+		// The mesh's vertex positions are interpreted as render-target offsets (Y increases downward), scaled by scale and translated by position.
+		// This is typically used for screen-space overlays such as glyph quads of text (see GlyphAtlas).
+		// No snapping or truncation is performed; callers can snap positions before calling if desired.
+		void RenderPixelMesh(const SpriteMesh& mesh, Vec2f position, float scale = 1.0f);
+
 		// Clears the current batch and updates the rendering configuration.
 		// After calling BeginBatch(), subsequent render calls append geometry to the batch, transformed according to this configuration.
 		// 
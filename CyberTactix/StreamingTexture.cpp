@@ -57,28 +57,39 @@ namespace pix
 	}
 
 	bool StreamingTexture::Lock(void** pixels, int* pitch)
+	{
+		return Lock(nullptr, pixels, pitch);
+	}
+
+	bool StreamingTexture::Lock(const SDL_Rect* rect, void** pixels, int* pitch)
 	{
 		if (isLocked_)
 		{
-			ErrorLogger::Get().LogError("StreamingTexture::Lock() failure", "Texture is already locked!");
+			ErrorLogger::Get().LogError(PIX_ERROR_HANDLE("StreamingTexture::Lock() failure"), "Texture is already locked!");
 			return false;
 		}
 
 		if (!sdlTexture_)
 		{
-			ErrorLogger::Get().LogError("StreamingTexture::Lock() failure", "Texture is not initialized!");
+			ErrorLogger::Get().LogError(PIX_ERROR_HANDLE("StreamingTexture::Lock() failure"), "Texture is not initialized!");
 			return false;
 		}
 
 		if (!pixels || !pitch)
 		{
-			ErrorLogger::Get().LogError("StreamingTexture::Lock() failure", "pixels or pitch is nullptr!");
+			ErrorLogger::Get().LogError(PIX_ERROR_HANDLE("StreamingTexture::Lock() failure"), "pixels or pitch is nullptr!");
 			return false;
 		}
 
-		if (SDL_LockTexture(sdlTexture_, nullptr, pixels, pitch) != 0)
+		if (!IsInside(rect))
 		{
-			ErrorLogger::Get().LogSDLError("StreamingTexture::Lock() - SDL_LockTexture() failure");
+			ErrorLogger::Get().LogError(PIX_ERROR_HANDLE("StreamingTexture::Lock() failure"), "rect is not inside the texture!");
+			return false;
+		}
+
+		if (SDL_LockTexture(sdlTexture_, rect, pixels, pitch) != 0)
+		{
+			ErrorLogger::Get().LogSDLError(PIX_ERROR_HANDLE("StreamingTexture::Lock() - SDL_LockTexture() failure"));
 			return false;
 		}
 
@@ -93,7 +104,7 @@ namespace pix
 
 		if (!sdlTexture_)
 		{
-			ErrorLogger::Get().LogError("StreamingTexture::Unlock() failure", "Texture is not initialized!");
+			ErrorLogger::Get().LogError(PIX_ERROR_HANDLE("StreamingTexture::Unlock() failure"), "Texture is not initialized!");
 			isLocked_ = false;
 			return;
 		}
@@ -103,4 +114,56 @@ namespace pix
 		isLocked_ = false;
 	}
 
+	bool StreamingTexture::Update(const SDL_Rect* rect, const void* pixels, int pitch)
+	{
+		if (isLocked_)
+		{
+			ErrorLogger::Get().LogError(PIX_ERROR_HANDLE("StreamingTexture::Update() failure"), "Texture must not be updated while locked!");
+			return false;
+		}
+
+		if (!sdlTexture_)
+		{
+			ErrorLogger::Get().LogError(PIX_ERROR_HANDLE("StreamingTexture::Update() failure"), "Texture is not initialized!");
+			return false;
+		}
+
+		if (!pixels)
+		{
+			ErrorLogger::Get().LogError(PIX_ERROR_HANDLE("StreamingTexture::Update() failure"), "pixels is nullptr!");
+			return false;
+		}
+
+		if (!IsInside(rect))
+		{
+			ErrorLogger::Get().LogError(PIX_ERROR_HANDLE("StreamingTexture::Update() failure"), "rect is not inside the texture!");
+			return false;
+		}
+
+		if (SDL_UpdateTexture(sdlTexture_, rect, pixels, pitch) != 0)
+		{
+			ErrorLogger::Get().LogSDLError(PIX_ERROR_HANDLE("StreamingTexture::Update() - SDL_UpdateTexture() failure"));
+			return false;
+		}
+
+		return true;
+	}
+
+	bool StreamingTexture::IsLocked() const
+	{
+		return isLocked_;
+	}
+
+
+
+	bool StreamingTexture::IsInside(const SDL_Rect* rect) const
+	{
+		if (!rect) return true;
+
+		int width = 0, height = 0;
+		GetSize(width, height);
+
+		return rect->x >= 0 && rect->y >= 0 && rect->w > 0 && rect->h > 0 && rect->x + rect->w <= width && rect->y + rect->h <= height;
+	}
+
 }
\ No newline at end of file
@@ -35,12 +35,32 @@ namespace pix
 		// Returns true on success, false otherwise.
 		bool Lock(void** pixels, int* pitch);
 
+		// Locks only the region rect for direct pixel access; rect = nullptr locks the whole texture.
+		// On success, *pixels points to the top-left pixel of rect, and *pitch specifies the number of bytes per row.
+		// The content of the locked region is undefined, so every pixel of rect must be written before Unlock().
+		// Pixels outside rect keep their content.
+		// Lock() fails if the texture is already locked or rect is not inside the texture.
+		// Returns true on success, false otherwise.
+		bool Lock(const SDL_Rect* rect, void** pixels, int* pitch);
+
 		// Applies the written pixel changes to the texture.
 		// Calling Unlock() without a matching successful Lock() is a no-op.
 		void Unlock();
 
+		// Uploads RGBA32 pixels from CPU memory into the region rect; rect = nullptr updates the whole texture.
+		// pixels points to the top-left pixel of the source region, and pitch specifies the number of bytes per source row.
+		// Unlike Lock(), only the given region is transferred, which is cheaper when only small dirty regions change per frame.
+		// Update() fails if the texture is locked or rect is not inside the texture.
+		// Returns true on success, false otherwise.
+		bool Update(const SDL_Rect* rect, const void* pixels, int pitch);
+
+		bool IsLocked() const;
+
 	private:
 
+		// Returns true if rect is nullptr or lies completely inside the texture
+		bool IsInside(const SDL_Rect* rect) const;
+
 		bool isLocked_ = false;
 	};
 }
@@ -100,4 +120,14 @@ if (streamingTexture.Lock(&pixels, &pitch))
 
 	streamingTexture.Unlock();
 }
+*/
+
+
+// Example usage 3: Update a dirty region only:
+// Uploads a 16 x 16 pixel region at (32, 48) from a CPU-side RGBA32 buffer of width bufferWidth.
+/*
+SDL_Rect dirtyRect = { 32, 48, 16, 16 };
+const SDL_Color* source = cpuPixels + dirtyRect.y * bufferWidth + dirtyRect.x;
+
+streamingTexture.Update(&dirtyRect, source, bufferWidth * (int)sizeof(SDL_Color));
 */
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include "StreamingTextureRing.h"
+#include "ErrorLogger.h"
+#include "PixMath.h"
+
+namespace pix
+{
+
+	StreamingTextureRing::StreamingTextureRing(int width, int height, int textureCount)
+	{
+		Realloc(width, height, textureCount);
+	}
+
+	bool StreamingTextureRing::Realloc(int width, int height, int textureCount)
+	{
+		for (int i = 0; i < textureCount_; i++)
+		{
+			if (textures_[i].IsLocked())
+			{
+				ErrorLogger::Get().LogError("StreamingTextureRing::Realloc() failure", "Textures must not be reallocated while locked!");
+				return false;
+			}
+		}
+
+		textureCount = GetClamped(textureCount, 1, MAX_TEXTURE_COUNT);
+
+		for (int i = 0; i < textureCount; i++)
+		{
+			if (!textures_[i].Realloc(width, height))
+			{
+				textureCount_ = 0;
+				return false;
+			}
+		}
+
+		// New textures start with the blend state of the first texture, so the whole ring looks alike
+		if (textureCount > textureCount_ && textureCount_ > 0)
+		{
+			Uint8 r = 255, g = 255, b = 255, a = 255;
+			textures_[0].GetRGBAMod(r, g, b, a);
+
+			for (int i = textureCount_; i < textureCount; i++)
+			{
+				textures_[i].SetBlendMode(textures_[0].GetBlendMode());
+				textures_[i].SetRGBAMod(r, g, b, a);
+				textures_[i].SetLinearFilter(textures_[0].IsLinearFilter());
+			}
+		}
+
+		textureCount_ = textureCount;
+		writeIndex_ = 0;
+		readIndex_ = 0;
+
+		return true;
+	}
+
+	StreamingTexture& StreamingTextureRing::GetWriteTexture()
+	{
+		return textures_[writeIndex_];
+	}
+
+	StreamingTexture& StreamingTextureRing::GetReadTexture()
+	{
+		return textures_[readIndex_];
+	}
+
+	void StreamingTextureRing::Advance()
+	{
+		if (textureCount_ == 0) return;
+
+		textures_[writeIndex_].Unlock();
+
+		readIndex_ = writeIndex_;
+		writeIndex_ = (writeIndex_ + 1) % textureCount_;
+	}
+
+	void StreamingTextureRing::SetBlendMode(SDL_BlendMode blendMode)
+	{
+		for (int i = 0; i < textureCount_; i++)
+			textures_[i].SetBlendMode(blendMode);
+	}
+
+	void StreamingTextureRing::SetRGBAMod(Uint8 r, Uint8 g, Uint8 b, Uint8 alpha)
+	{
+		for (int i = 0; i < textureCount_; i++)
+			textures_[i].SetRGBAMod(r, g, b, alpha);
+	}
+
+	void StreamingTextureRing::SetLinearFilter(bool isLinearFilter)
+	{
+		for (int i = 0; i < textureCount_; i++)
+			textures_[i].SetLinearFilter(isLinearFilter);
+	}
+
+	int StreamingTextureRing::GetTextureCount() const
+	{
+		return textureCount_;
+	}
+
+	bool StreamingTextureRing::IsInitialized() const
+	{
+		return textureCount_ > 0;
+	}
+
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Uncopyable.h"
+#include "StreamingTexture.h"
+
+namespace pix
+{
+	// StreamingTextureRing cycles through 2 or 3 StreamingTextures of equal size, so the CPU fills one texture
+	// while a previously filled texture is still being rendered.
+	//
+	// Technical note:
+	// Locking a texture that the GPU is still reading from can force the driver to wait until the draw call has finished.
+	// With a ring, the texture locked in frame N+1 is not the one drawn in frame N, which avoids that stall.
+	// Each texture keeps its own content. Partial updates via Lock(rect) or Update(rect) only touch the write texture,
+	// so with a ring of N textures a dirty region has to be written to each of the next N write textures to reach all of them.
+	//
+	// Usage:
+	// 1) Write the new frame into GetWriteTexture() via Lock()/Unlock() or Update().
+	// 2) Call Advance(); the written texture becomes the read texture.
+	// 3) Render GetReadTexture().
+	//
+	// Philosophy:
+	// StreamingTextureRing only manages the rotation. Blend state is applied to all textures alike,
+	// so the read texture looks the same no matter which texture of the ring it is.
+	class StreamingTextureRing : private Uncopyable
+	{
+	public:
+
+		static constexpr int MAX_TEXTURE_COUNT = 3;
+
+		StreamingTextureRing() = default;
+		StreamingTextureRing(int width, int height, int textureCount = 2);
+		~StreamingTextureRing() = default;
+
+		// Recreates all textures of the ring at the given size. textureCount is clamped to [1, MAX_TEXTURE_COUNT].
+		// Blend state is preserved as in StreamingTexture::Realloc(). Fails if any texture is locked.
+		// Returns true if all textures are recreated successfully, false otherwise.
+		bool Realloc(int width, int height, int textureCount = 2);
+
+		// Returns the texture the CPU writes the next frame into
+		StreamingTexture& GetWriteTexture();
+
+		// Returns the most recently completed texture, the one to render
+		StreamingTexture& GetReadTexture();
+
+		// Publishes the write texture as the new read texture and moves on to the next texture of the ring.
+		// Unlocks the write texture if it is still locked.
+		void Advance();
+
+		// Blend state setters apply to all textures of the ring
+		void SetBlendMode(SDL_BlendMode blendMode);
+		void SetRGBAMod(Uint8 r, Uint8 g, Uint8 b, Uint8 alpha);
+		void SetLinearFilter(bool isLinearFilter);
+
+		int GetTextureCount() const;
+
+		bool IsInitialized() const;
+
+	private:
+
+		StreamingTexture textures_[MAX_TEXTURE_COUNT];
+		int textureCount_ = 0;
+		int writeIndex_ = 0;
+		int readIndex_ = 0;
+	};
+}
@@ -1,4 +1,5 @@
 #include "Texture.h"
+#include "Renderer.h"
 #include "ErrorLogger.h"
 
 namespace pix
@@ -14,65 +15,129 @@ namespace pix
 	{
 		if (!sdlTexture_)
 		{
-			ErrorLogger::Get().LogError("Texture::SetBlendMode() failure", "sdlTexture_ is nullptr!");
+			ErrorLogger::Get().LogError(PIX_ERROR_HANDLE("Texture::SetBlendMode() failure"), "sdlTexture_ is nullptr!");
+			return;
+		}
+
+		if (CacheState() && blendMode == blendMode_)
+		{
+			Renderer::Get().RecordElidedCall();
 			return;
 		}
 
 		if (SDL_SetTextureBlendMode(sdlTexture_, blendMode) != 0)
-			ErrorLogger::Get().LogSDLError("Texture::SetBlendMode() - SDL_SetTextureBlendMode() failure");
+		{
+			ErrorLogger::Get().LogSDLError(PIX_ERROR_HANDLE("Texture::SetBlendMode() - SDL_SetTextureBlendMode() failure"));
+			isStateCached_ = false;
+			return;
+		}
+
+		blendMode_ = blendMode;
 	}
 
 	void Texture::SetColorMod(Uint8 r, Uint8 g, Uint8 b)
 	{
 		if (!sdlTexture_)
 		{
-			ErrorLogger::Get().LogError("Texture::SetColorMod() failure", "sdlTexture_ is nullptr!");
+			ErrorLogger::Get().LogError(PIX_ERROR_HANDLE("Texture::SetColorMod() failure"), "sdlTexture_ is nullptr!");
+			return;
+		}
+
+		if (CacheState() && r == rgbaMod_.r && g == rgbaMod_.g && b == rgbaMod_.b)
+		{
+			Renderer::Get().RecordElidedCall();
 			return;
 		}
 
 		if (SDL_SetTextureColorMod(sdlTexture_, r, g, b) != 0)
-			ErrorLogger::Get().LogSDLError("Texture::SetColorMod() - SDL_SetTextureColorMod() failure");
+		{
+			ErrorLogger::Get().LogSDLError(PIX_ERROR_HANDLE("Texture::SetColorMod() - SDL_SetTextureColorMod() failure"));
+			isStateCached_ = false;
+			return;
+		}
+
+		rgbaMod_.r = r;
+		rgbaMod_.g = g;
+		rgbaMod_.b = b;
 	}
 
 	void Texture::SetAlphaMod(Uint8 alpha)
 	{
 		if (!sdlTexture_)
 		{
-			ErrorLogger::Get().LogError("Texture::SetAlphaMod() failure", "sdlTexture_ is nullptr!");
+			ErrorLogger::Get().LogError(PIX_ERROR_HANDLE("Texture::SetAlphaMod() failure"), "sdlTexture_ is nullptr!");
+			return;
+		}
+
+		if (CacheState() && alpha == rgbaMod_.a)
+		{
+			Renderer::Get().RecordElidedCall();
 			return;
 		}
 
 		if (SDL_SetTextureAlphaMod(sdlTexture_, alpha) != 0)
-			ErrorLogger::Get().LogSDLError("Texture::SetAlphaMod() - SDL_SetTextureAlphaMod() failure");
+		{
+			ErrorLogger::Get().LogSDLError(PIX_ERROR_HANDLE("Texture::SetAlphaMod() - SDL_SetTextureAlphaMod() failure"));
+			isStateCached_ = false;
+			return;
+		}
+
+		rgbaMod_.a = alpha;
 	}
 
 	void Texture::SetRGBAMod(Uint8 r, Uint8 g, Uint8 b, Uint8 a)
 	{
 		if (!sdlTexture_)
 		{
-			ErrorLogger::Get().LogError("Texture::SetRGBAMod() failure", "sdlTexture_ is nullptr!");
+			ErrorLogger::Get().LogError(PIX_ERROR_HANDLE("Texture::SetRGBAMod() failure"), "sdlTexture_ is nullptr!");
 			return;
 		}
 
-		if (SDL_SetTextureColorMod(sdlTexture_, r, g, b) != 0)
-			ErrorLogger::Get().LogSDLError("Texture::SetRGBAMod() - SDL_SetTextureColorMod() failure");
+		const bool isCached = CacheState();
 
-		if (SDL_SetTextureAlphaMod(sdlTexture_, a) != 0)
-			ErrorLogger::Get().LogSDLError("Texture::SetRGBAMod() - SDL_SetTextureAlphaMod() failure");
+		if (isCached && r == rgbaMod_.r && g == rgbaMod_.g && b == rgbaMod_.b)
+		{
+			Renderer::Get().RecordElidedCall();
+		}
+		else if (SDL_SetTextureColorMod(sdlTexture_, r, g, b) != 0)
+		{
+			ErrorLogger::Get().LogSDLError(PIX_ERROR_HANDLE("Texture::SetRGBAMod() - SDL_SetTextureColorMod() failure"));
+			isStateCached_ = false;
+		}
+		else
+		{
+			rgbaMod_.r = r;
+			rgbaMod_.g = g;
+			rgbaMod_.b = b;
+		}
+
+		if (isCached && a == rgbaMod_.a)
+		{
+			Renderer::Get().RecordElidedCall();
+		}
+		else if (SDL_SetTextureAlphaMod(sdlTexture_, a) != 0)
+		{
+			ErrorLogger::Get().LogSDLError(PIX_ERROR_HANDLE("Texture::SetRGBAMod() - SDL_SetTextureAlphaMod() failure"));
+			isStateCached_ = false;
+		}
+		else
+		{
+			rgbaMod_.a = a;
+		}
 	}
 
 	void Texture::SetLinearFilter(bool isLinearFilter)
 	{
 		if (!sdlTexture_)
 		{
-			ErrorLogger::Get().LogError("Texture::SetLinearFilter() failure", "sdlTexture_ is nullptr!");
+			ErrorLogger::Get().LogError(PIX_ERROR_HANDLE("Texture::SetLinearFilter() failure"), "sdlTexture_ is nullptr!");
 			return;
 		}
 
 		const SDL_ScaleMode scaleMode = isLinearFilter ? SDL_ScaleModeLinear : SDL_ScaleModeNearest;
 
 		if (SDL_SetTextureScaleMode(sdlTexture_, scaleMode) != 0)
-			ErrorLogger::Get().LogSDLError("Texture::SetLinearFilter() - SDL_SetTextureScaleMode() failure");
+			ErrorLogger::Get().LogSDLError(PIX_ERROR_HANDLE("Texture::SetLinearFilter() - SDL_SetTextureScaleMode() failure"));
 			
 	}
 
@@ -83,57 +148,73 @@ namespace pix
 	{
 		if (!sdlTexture_)
 		{
-			ErrorLogger::Get().LogError("Texture::GetBlendMode() failure", "sdlTexture_ is nullptr!");
+			ErrorLogger::Get().LogError(PIX_ERROR_HANDLE("Texture::GetBlendMode() failure"), "sdlTexture_ is nullptr!");
 			return  SDL_BLENDMODE_INVALID;
 		}
 
-		SDL_BlendMode blendMode = SDL_BLENDMODE_INVALID;
-		if (SDL_GetTextureBlendMode(sdlTexture_, &blendMode) != 0)
-			ErrorLogger::Get().LogSDLError("Texture::GetBlendMode() - SDL_GetTextureBlendMode() failure");
+		if (!CacheState())
+		{
+			ErrorLogger::Get().LogError(PIX_ERROR_HANDLE("Texture::GetBlendMode() failure"), "Failed to read the texture state!");
+			return SDL_BLENDMODE_INVALID;
+		}
 
-		return blendMode;
+		return blendMode_;
 	}
 
 	void Texture::GetRGBMod(Uint8& r, Uint8& g, Uint8& b) const
 	{
 		if (!sdlTexture_)
 		{
-			ErrorLogger::Get().LogError("Texture::GetRGBMod() failure", "sdlTexture_ is nullptr!");
+			ErrorLogger::Get().LogError(PIX_ERROR_HANDLE("Texture::GetRGBMod() failure"), "sdlTexture_ is nullptr!");
 			return;
 		}
 
-		if (SDL_GetTextureColorMod(sdlTexture_, &r, &g, &b) != 0)
-			ErrorLogger::Get().LogSDLError("Texture::GetRGBMod() - SDL_GetTextureColorMod() failure");
+		if (!CacheState())
+		{
+			ErrorLogger::Get().LogError(PIX_ERROR_HANDLE("Texture::GetRGBMod() failure"), "Failed to read the texture state!");
+			return;
+		}
+
+		r = rgbaMod_.r;
+		g = rgbaMod_.g;
+		b = rgbaMod_.b;
 	}
 
 	Uint8 Texture::GetAlphaMod() const 
 	{
 		if (!sdlTexture_)
 		{
-			ErrorLogger::Get().LogError("Texture::GetAlphaMod() failure", "sdlTexture_ is nullptr!");
+			ErrorLogger::Get().LogError(PIX_ERROR_HANDLE("Texture::GetAlphaMod() failure"), "sdlTexture_ is nullptr!");
 			return 0;
 		}
 
-		Uint8 alphaMod = 0;
-		if (SDL_GetTextureAlphaMod(sdlTexture_, &alphaMod) != 0)
-			ErrorLogger::Get().LogSDLError("Texture::GetAlphaMod() - SDL_GetTextureAlphaMod() failure");
+		if (!CacheState())
+		{
+			ErrorLogger::Get().LogError(PIX_ERROR_HANDLE("Texture::GetAlphaMod() failure"), "Failed to read the texture state!");
+			return 0;
+		}
 
-		return alphaMod;
+		return rgbaMod_.a;
 	}
 
 	void Texture::GetRGBAMod(Uint8& r, Uint8& g, Uint8& b, Uint8& a) const
 	{
 		if (!sdlTexture_)
 		{
-			ErrorLogger::Get().LogError("Texture::GetRGBAMod() failure", "sdlTexture_ is nullptr!");
+			ErrorLogger::Get().LogError(PIX_ERROR_HANDLE("Texture::GetRGBAMod() failure"), "sdlTexture_ is nullptr!");
 			return;
 		}
 
-		if (SDL_GetTextureColorMod(sdlTexture_, &r, &g, &b) != 0)
-			ErrorLogger::Get().LogSDLError("Texture::GetRGBAMod() - SDL_GetTextureColorMod() failure");
+		if (!CacheState())
+		{
+			ErrorLogger::Get().LogError(PIX_ERROR_HANDLE("Texture::GetRGBAMod() failure"), "Failed to read the texture state!");
+			return;
+		}
 
-		if (SDL_GetTextureAlphaMod(sdlTexture_, &a) != 0)
-			ErrorLogger::Get().LogSDLError("Texture::GetRGBAMod() - SDL_GetTextureAlphaMod() failure");
+		r = rgbaMod_.r;
+		g = rgbaMod_.g;
+		b = rgbaMod_.b;
+		a = rgbaMod_.a;
 	}
 
 
@@ -141,12 +222,12 @@ namespace pix
 	{
 		if (!sdlTexture_)
 		{
-			ErrorLogger::Get().LogError("Texture::GetSize() failure", "sdlTexture_ is nullptr!");
+			ErrorLogger::Get().LogError(PIX_ERROR_HANDLE("Texture::GetSize() failure"), "sdlTexture_ is nullptr!");
 			return;
 		}
 
 		if (SDL_QueryTexture(sdlTexture_, nullptr, nullptr, &width, &height) != 0)
-			ErrorLogger::Get().LogSDLError("Texture::GetSize() - SDL_QueryTexture() failure");
+			ErrorLogger::Get().LogSDLError(PIX_ERROR_HANDLE("Texture::GetSize() - SDL_QueryTexture() failure"));
 	}
 
 	SDL_Texture* Texture::GetSDLTexture() const
@@ -158,7 +239,7 @@ namespace pix
 	{
 		if (!sdlTexture_)
 		{
-			ErrorLogger::Get().LogError("Texture::IsLinearFilter() failure", "sdlTexture_ is nullptr!");
+			ErrorLogger::Get().LogError(PIX_ERROR_HANDLE("Texture::IsLinearFilter() failure"), "sdlTexture_ is nullptr!");
 			return false;
 		}
 
@@ -166,7 +247,7 @@ namespace pix
 
 		if (SDL_GetTextureScaleMode(sdlTexture_, &scaleMode) != 0)
 		{
-			ErrorLogger::Get().LogSDLError("Texture::IsLinearFilter() - SDL_GetTextureScaleMode() failure");
+			ErrorLogger::Get().LogSDLError(PIX_ERROR_HANDLE("Texture::IsLinearFilter() - SDL_GetTextureScaleMode() failure"));
 			return false;
 		}
 
@@ -180,13 +261,39 @@ namespace pix
 
 	void Texture::DestroySDLTexture()
 	{
+		isStateCached_ = false; // The next SDL_Texture starts with its own state
+
 		if (sdlTexture_)
 		{
 			SDL_DestroyTexture(sdlTexture_);
+			Renderer::Get().OnTextureDestroyed(sdlTexture_); // Pointer comparison only
 			sdlTexture_ = nullptr;
 		}
 	}
 
+
+
+	bool Texture::CacheState() const
+	{
+		if (isStateCached_) return true;
+
+		if (SDL_GetTextureBlendMode(sdlTexture_, &blendMode_) != 0)
+		{
+			ErrorLogger::Get().LogSDLError(PIX_ERROR_HANDLE("Texture::CacheState() - SDL_GetTextureBlendMode() failure"));
+			return false;
+		}
+
+		if (SDL_GetTextureColorMod(sdlTexture_, &rgbaMod_.r, &rgbaMod_.g, &rgbaMod_.b) != 0 || SDL_GetTextureAlphaMod(sdlTexture_, &rgbaMod_.a) != 0)
+		{
+			ErrorLogger::Get().LogSDLError(PIX_ERROR_HANDLE("Texture::CacheState() - SDL_GetTextureColorMod()/SDL_GetTextureAlphaMod() failure"));
+			return false;
+		}
+
+		isStateCached_ = true;
+
+		return true;
+	}
+
 }
 
 
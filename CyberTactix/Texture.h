@@ -20,6 +20,10 @@ namespace pix
 	// Since multiple texture types share common state and behavior, Texture serves as a common base class for concrete texture types.
 	// 
 	// Note: On failure, getters tend to return semantically invalid values to make misuse visible.
+	//
+	// Technical note:
+	// Blend mode and color modulation are shadowed on the first access. Setters skip the SDL call if the state does not change,
+	// and getters return the shadowed state. Changing this state through the exposed SDL_Texture bypasses the shadow.
 	class Texture : private Uncopyable        
 	{
 	public:
@@ -79,5 +83,16 @@ namespace pix
 		void DestroySDLTexture(); 
 
 		SDL_Texture* sdlTexture_ = nullptr;
+
+	private:
+
+		// Reads blend mode and color modulation from sdlTexture_ into the shadowed state, unless already done.
+		// Returns false if the state could not be read.
+		bool CacheState() const;
+
+		// Shadowed state, valid while isStateCached_ is true
+		mutable SDL_BlendMode blendMode_ = SDL_BLENDMODE_INVALID;
+		mutable SDL_Color rgbaMod_ = { 255, 255, 255, 255 };
+		mutable bool isStateCached_ = false;
 	};
 }
\ No newline at end of file
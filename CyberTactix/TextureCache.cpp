@@ -0,0 +1,209 @@
+#include "TextureCache.h"
+#include <vector>
+#include "ErrorLogger.h"
+
+namespace pix
+{
+
+	TextureCache::TextureCache(Sint64 memoryBudget) :
+		memoryBudget_(memoryBudget < 0 ? 0 : memoryBudget)
+	{
+	}
+
+	std::shared_ptr<ImageTexture> TextureCache::Get(const std::string& imagePath)
+	{
+		const std::string normalizedPath = GetNormalizedPath(imagePath);
+
+		auto it = entryLookup_.find(normalizedPath);
+
+		if (it != entryLookup_.end())
+		{
+			// Move the entry to the front of the LRU order
+			entries_.splice(entries_.begin(), entries_, it->second);
+			statistics_.HitCount++;
+
+			return entries_.front().Texture;
+		}
+
+		statistics_.MissCount++;
+
+		std::shared_ptr<ImageTexture> texture = std::make_shared<ImageTexture>();
+
+		if (!texture->Reload(normalizedPath))
+		{
+			ErrorLogger::Get().LogError("TextureCache::Get() failure", "Failed to load " + normalizedPath + "!");
+			return std::shared_ptr<ImageTexture>();
+		}
+
+		Entry entry;
+		entry.NormalizedPath = normalizedPath;
+		entry.Texture = texture;
+		entry.MemorySize = GetMemorySize(*texture);
+
+		entries_.push_front(entry);
+		entryLookup_[normalizedPath] = entries_.begin();
+		memoryUsage_ += entry.MemorySize;
+
+		EvictToBudget();
+
+		return texture;
+	}
+
+	void TextureCache::SetMemoryBudget(Sint64 memoryBudget)
+	{
+		memoryBudget_ = memoryBudget < 0 ? 0 : memoryBudget;
+
+		EvictToBudget();
+	}
+
+	int TextureCache::EvictUnused()
+	{
+		int evictedCount = 0;
+
+		for (auto it = entries_.begin(); it != entries_.end();)
+		{
+			if (it->Texture.use_count() == 1)
+			{
+				memoryUsage_ -= it->MemorySize;
+				entryLookup_.erase(it->NormalizedPath);
+				it = entries_.erase(it);
+				evictedCount++;
+			}
+			else
+			{
+				++it;
+			}
+		}
+
+		statistics_.EvictionCount += evictedCount;
+
+		return evictedCount;
+	}
+
+	void TextureCache::Clear()
+	{
+		entries_.clear();
+		entryLookup_.clear();
+		memoryUsage_ = 0;
+	}
+
+	void TextureCache::ResetStatistics()
+	{
+		statistics_ = Statistics();
+	}
+
+	const TextureCache::Statistics& TextureCache::GetStatistics() const
+	{
+		return statistics_;
+	}
+
+	Sint64 TextureCache::GetMemoryUsage() const
+	{
+		return memoryUsage_;
+	}
+
+	Sint64 TextureCache::GetMemoryBudget() const
+	{
+		return memoryBudget_;
+	}
+
+	int TextureCache::GetTextureCount() const
+	{
+		return entries_.size();
+	}
+
+	bool TextureCache::Contains(const std::string& imagePath) const
+	{
+		return entryLookup_.find(GetNormalizedPath(imagePath)) != entryLookup_.end();
+	}
+
+	std::string TextureCache::GetNormalizedPath(const std::string& imagePath)
+	{
+		std::vector<std::string> segments;
+		std::string segment;
+
+		const bool isAbsolute = !imagePath.empty() && (imagePath[0] == '/' || imagePath[0] == '\\');
+
+		const int length = imagePath.size();
+
+		for (int i = 0; i <= length; i++)
+		{
+			const char c = i < length ? imagePath[i] : '/';
+
+			if (c != '/' && c != '\\')
+			{
+				segment += c;
+				continue;
+			}
+
+			if (segment == "..")
+			{
+				// Only cancel out a preceding real segment; leading ".." segments of relative paths are kept
+				if (!segments.empty() && segments.back() != "..")
+					segments.pop_back();
+				else if (!isAbsolute)
+					segments.push_back(segment);
+			}
+			else if (!segment.empty() && segment != ".")
+			{
+				segments.push_back(segment);
+			}
+
+			segment.clear();
+		}
+
+		std::string normalizedPath = isAbsolute ? "/" : "";
+
+		const int segmentCount = segments.size();
+
+		for (int i = 0; i < segmentCount; i++)
+		{
+			if (i > 0) normalizedPath += '/';
+			normalizedPath += segments[i];
+		}
+
+		return normalizedPath;
+	}
+
+
+
+	void TextureCache::EvictToBudget()
+	{
+		// Handles are released without notice to the cache, so the unreferenced memory is summed up on demand
+		Sint64 unusedMemory = 0;
+
+		for (const Entry& entry : entries_)
+		{
+			if (entry.Texture.use_count() == 1)
+				unusedMemory += entry.MemorySize;
+		}
+
+		if (unusedMemory <= memoryBudget_) return;
+
+		// Walk from the least recently used entry towards the front
+		auto it = entries_.end();
+
+		while (it != entries_.begin() && unusedMemory > memoryBudget_)
+		{
+			--it;
+
+			if (it->Texture.use_count() == 1)
+			{
+				unusedMemory -= it->MemorySize;
+				memoryUsage_ -= it->MemorySize;
+				entryLookup_.erase(it->NormalizedPath);
+				it = entries_.erase(it);
+				statistics_.EvictionCount++;
+			}
+		}
+	}
+
+	Sint64 TextureCache::GetMemorySize(const ImageTexture& texture)
+	{
+		int width = 0, height = 0;
+		texture.GetSize(width, height);
+
+		return (Sint64)width * height * 4;
+	}
+
+}
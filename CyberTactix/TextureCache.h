@@ -0,0 +1,92 @@
+#pragma once
+
+#include <string>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <SDL_stdinc.h>
+#include "Uncopyable.h"
+#include "ImageTexture.h"
+
+namespace pix
+{
+	// TextureCache loads ImageTexture objects on demand and hands out shared handles to them, keyed by normalized image path.
+	// Requesting the same image twice returns the same texture instead of loading the image again.
+	//
+	// Technical note:
+	// The memory of a texture is estimated from its size as width * height * 4 bytes, since SDL does not expose the real GPU allocation.
+	// Textures that are only referenced by the cache are kept for reuse and evicted in least-recently-used order
+	// whenever their estimated memory exceeds the memory budget. Textures still referenced by a handle are never evicted
+	// and do not count against the budget, so the total memory of the cache can exceed it.
+	// Paths are normalized by unifying separators to '/' and resolving "." and ".." segments. Letter case is kept as is.
+	//
+	// Philosophy:
+	// Ownership of a cached texture is shared between the cache and all handles. A handle stays valid after the texture has
+	// been evicted or the cache has been cleared; the texture is destroyed with its last handle.
+	// All handles and the cache must be destroyed before the Renderer, like any other Texture.
+	class TextureCache : private Uncopyable
+	{
+	public:
+
+		struct Statistics
+		{
+			int HitCount = 0;      // Get() calls served from the cache
+			int MissCount = 0;     // Get() calls that had to load the image
+			int EvictionCount = 0; // Textures dropped to satisfy the memory budget
+		};
+
+		// memoryBudget is the estimated texture memory in bytes that unreferenced cached textures may occupy
+		explicit TextureCache(Sint64 memoryBudget = 256 * 1024 * 1024);
+		~TextureCache() = default;
+
+		// Returns a shared handle to the texture of the given image, loading it if it is not cached yet.
+		// Returns an empty handle if the image cannot be loaded. Failed loads are not cached.
+		std::shared_ptr<ImageTexture> Get(const std::string& imagePath);
+
+		// Sets the memory budget in bytes and evicts unreferenced textures until it is met, if possible
+		void SetMemoryBudget(Sint64 memoryBudget);
+
+		// Evicts all textures that are only referenced by the cache.
+		// Returns the number of evicted textures.
+		int EvictUnused();
+
+		// Drops all cache references. Textures still referenced by handles stay alive until their last handle is destroyed.
+		void Clear();
+
+		void ResetStatistics();
+
+		const Statistics& GetStatistics() const;
+
+		// Returns the estimated memory of all cached textures in bytes
+		Sint64 GetMemoryUsage() const;
+
+		Sint64 GetMemoryBudget() const;
+
+		int GetTextureCount() const;
+
+		bool Contains(const std::string& imagePath) const;
+
+		// Returns imagePath with '/' separators and resolved "." and ".." segments
+		static std::string GetNormalizedPath(const std::string& imagePath);
+
+	private:
+
+		struct Entry
+		{
+			std::string NormalizedPath;
+			std::shared_ptr<ImageTexture> Texture;
+			Sint64 MemorySize = 0;
+		};
+
+		// Evicts least recently used unreferenced textures until their memory is within the budget
+		void EvictToBudget();
+
+		static Sint64 GetMemorySize(const ImageTexture& texture);
+
+		std::list<Entry> entries_; // Most recently used first
+		std::unordered_map<std::string, std::list<Entry>::iterator> entryLookup_;
+		Statistics statistics_;
+		Sint64 memoryUsage_ = 0;
+		Sint64 memoryBudget_ = 0;
+	};
+}
@@ -1,19 +1,235 @@
 #include "TextureOps.h"
+#include <algorithm>
+#include <numeric>
 #include "Renderer.h"
 #include "ErrorLogger.h"
 
 
 namespace pix
 {
+	namespace
+	{
+		constexpr int ATLAS_PADDING = 1; // Transparent pixels between atlas regions
+		constexpr int DEFAULT_ATLAS_WIDTH = 2048;
+
+		// Appends a quad that maps textureRect of a textureWidth x textureHeight texture onto destinationRect.
+		// Vertices are in the order TopLeft, TopRight, BottomRight, BottomLeft.
+		void AppendQuad(std::vector<SDL_Vertex>& vertices, const SDL_Rect& destinationRect, const SDL_Rect& textureRect, int textureWidth, int textureHeight)
+		{
+			const float left = (float)destinationRect.x;
+			const float top = (float)destinationRect.y;
+			const float right = (float)(destinationRect.x + destinationRect.w);
+			const float bottom = (float)(destinationRect.y + destinationRect.h);
+
+			const float uvLeft = (float)textureRect.x / textureWidth;
+			const float uvTop = (float)textureRect.y / textureHeight;
+			const float uvRight = (float)(textureRect.x + textureRect.w) / textureWidth;
+			const float uvBottom = (float)(textureRect.y + textureRect.h) / textureHeight;
+
+			const SDL_Color white = { 255, 255, 255, 255 };
+
+			vertices.push_back(SDL_Vertex{ SDL_FPoint{ left, top }, white, SDL_FPoint{ uvLeft, uvTop } });
+			vertices.push_back(SDL_Vertex{ SDL_FPoint{ right, top }, white, SDL_FPoint{ uvRight, uvTop } });
+			vertices.push_back(SDL_Vertex{ SDL_FPoint{ right, bottom }, white, SDL_FPoint{ uvRight, uvBottom } });
+			vertices.push_back(SDL_Vertex{ SDL_FPoint{ left, bottom }, white, SDL_FPoint{ uvLeft, uvBottom } });
+		}
+	}
+
+
 
 	bool BlendTextureRegion(Texture& sourceTexture, const SDL_Rect* sourceRect, const Texture& modifierTexture, const SDL_Rect* modifierRect, TargetTexture& outputTexture)
 	{
-		return false; // TODO
+		if (!sourceTexture.IsInitialized() || !modifierTexture.IsInitialized())
+		{
+			ErrorLogger::Get().LogError("BlendTextureRegion() failure", "Source or modifier texture is not initialized!");
+			return false;
+		}
+
+		int width = 0, height = 0;
+
+		if (sourceRect)
+		{
+			width = sourceRect->w;
+			height = sourceRect->h;
+		}
+		else
+		{
+			sourceTexture.GetSize(width, height);
+		}
+
+		if (width <= 0 || height <= 0)
+		{
+			ErrorLogger::Get().LogError("BlendTextureRegion() failure", "The source region is empty!");
+			return false;
+		}
+
+		int outputWidth = 0, outputHeight = 0;
+		if (outputTexture.IsInitialized())
+			outputTexture.GetSize(outputWidth, outputHeight);
+
+		if ((outputWidth != width || outputHeight != height) && !outputTexture.Realloc(width, height))
+			return false;
+
+		Renderer& renderer = Renderer::Get();
+
+		if (!renderer.SetRenderTarget(&outputTexture))
+			return false;
+
+		renderer.SetRenderScale(1.0f, 1.0f);
+
+		// Copy the source region as it is, then restore the blend mode before the modifier pass, which may use the same texture
+		const SDL_BlendMode sourceBlendMode = sourceTexture.GetBlendMode();
+		sourceTexture.SetBlendMode(SDL_BLENDMODE_NONE);
+
+		bool isRendered = renderer.Render(sourceTexture, sourceRect, nullptr);
+
+		sourceTexture.SetBlendMode(sourceBlendMode);
+
+		isRendered = renderer.Render(modifierTexture, modifierRect, nullptr) && isRendered;
+
+		renderer.SetRenderTarget(nullptr);
+
+		if (!isRendered)
+			ErrorLogger::Get().LogSDLError("BlendTextureRegion() - Renderer::Render() failure");
+
+		return isRendered;
 	}
 
 	bool BlendTextureRegion(Texture& texture, const SDL_Rect* sourceRect, const SDL_Rect* modifierRect, TargetTexture& outputTexture)
 	{
-		return false; // TODO
+		return BlendTextureRegion(texture, sourceRect, texture, modifierRect, outputTexture);
+	}
+
+	bool BlendTextureRegions(Texture& sourceTexture, const Texture& modifierTexture, std::vector<BlendTextureRegionJob>& jobs, TargetTexture& atlasTexture, int atlasWidth)
+	{
+		if (jobs.empty()) return true;
+
+		if (!sourceTexture.IsInitialized() || !modifierTexture.IsInitialized())
+		{
+			ErrorLogger::Get().LogError("BlendTextureRegions() failure", "Source or modifier texture is not initialized!");
+			return false;
+		}
+
+		Renderer& renderer = Renderer::Get();
+
+		SDL_RendererInfo rendererInfo;
+		if (SDL_GetRendererInfo(renderer.GetSDLRenderer(), &rendererInfo) != 0)
+		{
+			rendererInfo.max_texture_width = 0;
+			rendererInfo.max_texture_height = 0;
+		}
+
+		if (atlasWidth <= 0)
+			atlasWidth = rendererInfo.max_texture_width > 0 ? std::min(DEFAULT_ATLAS_WIDTH, rendererInfo.max_texture_width) : DEFAULT_ATLAS_WIDTH;
+
+		// Shelf packing in order of decreasing height keeps the shelves tight
+		const int jobCount = jobs.size();
+
+		std::vector<int> packingOrder(jobCount);
+		std::iota(packingOrder.begin(), packingOrder.end(), 0);
+		std::stable_sort(packingOrder.begin(), packingOrder.end(), [&jobs](int a, int b) { return jobs[a].SourceRect.h > jobs[b].SourceRect.h; });
+
+		int shelfX = 0;
+		int shelfY = 0;
+		int shelfHeight = 0;
+
+		for (int i = 0; i < jobCount; i++)
+		{
+			BlendTextureRegionJob& job = jobs[packingOrder[i]];
+			const int width = job.SourceRect.w;
+			const int height = job.SourceRect.h;
+
+			if (width <= 0 || height <= 0 || width > atlasWidth)
+			{
+				ErrorLogger::Get().LogError("BlendTextureRegions() failure", "A source region is empty or wider than the atlas!");
+				return false;
+			}
+
+			if (shelfX + width > atlasWidth)
+			{
+				shelfX = 0;
+				shelfY += shelfHeight + ATLAS_PADDING;
+				shelfHeight = 0;
+			}
+
+			job.OutputRect = SDL_Rect{ shelfX, shelfY, width, height };
+
+			shelfX += width + ATLAS_PADDING;
+			shelfHeight = std::max(shelfHeight, height);
+		}
+
+		const int atlasHeight = shelfY + shelfHeight;
+
+		if (rendererInfo.max_texture_height > 0 && atlasHeight > rendererInfo.max_texture_height)
+		{
+			ErrorLogger::Get().LogError("BlendTextureRegions() failure", "The packed atlas exceeds the maximum texture height!");
+			return false;
+		}
+
+		int currentWidth = 0, currentHeight = 0;
+		if (atlasTexture.IsInitialized())
+			atlasTexture.GetSize(currentWidth, currentHeight);
+
+		if ((currentWidth != atlasWidth || currentHeight != atlasHeight) && !atlasTexture.Realloc(atlasWidth, atlasHeight))
+			return false;
+
+		// Build both geometry batches; they share the same index list
+		int sourceWidth = 0, sourceHeight = 0, modifierWidth = 0, modifierHeight = 0;
+		sourceTexture.GetSize(sourceWidth, sourceHeight);
+		modifierTexture.GetSize(modifierWidth, modifierHeight);
+
+		std::vector<SDL_Vertex> sourceVertices;
+		std::vector<SDL_Vertex> modifierVertices;
+		std::vector<int> indices;
+
+		sourceVertices.reserve(jobCount * 4);
+		modifierVertices.reserve(jobCount * 4);
+		indices.reserve(jobCount * 6);
+
+		for (int i = 0; i < jobCount; i++)
+		{
+			AppendQuad(sourceVertices, jobs[i].OutputRect, jobs[i].SourceRect, sourceWidth, sourceHeight);
+			AppendQuad(modifierVertices, jobs[i].OutputRect, jobs[i].ModifierRect, modifierWidth, modifierHeight);
+
+			const int firstVertex = i * 4;
+			const int quadIndices[6] = { 0, 1, 2, 2, 3, 0 };
+
+			for (int j = 0; j < 6; j++)
+				indices.push_back(firstVertex + quadIndices[j]);
+		}
+
+		if (!renderer.SetRenderTarget(&atlasTexture))
+			return false;
+
+		renderer.SetRenderScale(1.0f, 1.0f);
+
+		// Clear the padding and any previous content to transparent
+		Uint8 r, g, b, a;
+		renderer.GetRenderColor(r, g, b, a);
+		renderer.SetRenderColor(0, 0, 0, 0);
+		renderer.Clear();
+		renderer.SetRenderColor(r, g, b, a);
+
+		const SDL_BlendMode sourceBlendMode = sourceTexture.GetBlendMode();
+		sourceTexture.SetBlendMode(SDL_BLENDMODE_NONE);
+
+		bool isRendered = renderer.RenderGeometry(sourceTexture, sourceVertices.data(), sourceVertices.size(), indices.data(), indices.size());
+
+		sourceTexture.SetBlendMode(sourceBlendMode);
+
+		isRendered = renderer.RenderGeometry(modifierTexture, modifierVertices.data(), modifierVertices.size(), indices.data(), indices.size()) && isRendered;
+
+		renderer.SetRenderTarget(nullptr);
+
+		if (!isRendered)
+			ErrorLogger::Get().LogSDLError("BlendTextureRegions() - Renderer::RenderGeometry() failure");
+
+		return isRendered;
+	}
+
+	bool BlendTextureRegions(Texture& texture, std::vector<BlendTextureRegionJob>& jobs, TargetTexture& atlasTexture, int atlasWidth)
+	{
+		return BlendTextureRegions(texture, texture, jobs, atlasTexture, atlasWidth);
 	}
 
-}
\ No newline at end of file
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <vector>
 #include <SDL_rect.h>
 #include "TargetTexture.h"
 
@@ -13,6 +14,7 @@ namespace pix
     // If modifierRect is nullptr, the full modifier texture is used.
     // outputTexture is reallocated only if its size does not match the source region size.
     // The source texture's blend mode is temporarily changed internally and restored before returning.
+    // Afterwards the default backbuffer is the render target.
     bool BlendTextureRegion(Texture& sourceTexture, const SDL_Rect* sourceRect, const Texture& modifierTexture, const SDL_Rect* modifierRect, TargetTexture& outputTexture);
 
     // Renders a modified texture region into outputTexture using two regions from the same texture.
@@ -22,6 +24,32 @@ namespace pix
     // If modifierRect is nullptr, the full texture is used as the modifier region.
     // outputTexture is reallocated only if its size does not match the source region size.
     // The texture's blend mode is temporarily changed internally and restored before returning.
+    // Afterwards the default backbuffer is the render target.
     bool BlendTextureRegion(Texture& texture, const SDL_Rect* sourceRect, const SDL_Rect* modifierRect, TargetTexture& outputTexture);
 
-}
\ No newline at end of file
+
+
+    // One region of a BlendTextureRegions() batch
+    struct BlendTextureRegionJob
+    {
+        SDL_Rect SourceRect = { 0, 0, 0, 0 };   // Region of the source texture
+        SDL_Rect ModifierRect = { 0, 0, 0, 0 }; // Region of the modifier texture, stretched over the source region
+        SDL_Rect OutputRect = { 0, 0, 0, 0 };   // Set by BlendTextureRegions(): region of the atlas that holds the result
+    };
+
+    // Batched BlendTextureRegion() for many regions, e.g. palette-swapped or damage-flash variants of all sprites of a sprite sheet.
+    // The results are shelf-packed into atlasTexture, and OutputRect of each job is set to its region in the atlas.
+    // All jobs are executed with one render-target switch and two geometry batches (sources, then modifiers).
+    // atlasWidth is the width of the atlas; if it is not positive, min(2048, maximum texture width) is used.
+    // The atlas height is the packed height. atlasTexture is reallocated only if its size does not match, and is cleared to transparent.
+    // Regions are separated by one transparent pixel to prevent bleeding with linear filtering.
+    // The source texture's blend mode is temporarily changed internally and restored before returning.
+    // Afterwards the default backbuffer is the render target.
+    // Returns false without rendering if a region does not fit into the atlas or the texture size limit.
+    bool BlendTextureRegions(Texture& sourceTexture, const Texture& modifierTexture, std::vector<BlendTextureRegionJob>& jobs, TargetTexture& atlasTexture, int atlasWidth = 0);
+
+    // Batched BlendTextureRegion() with source and modifier regions from the same texture.
+    // Behaves like the overload above; the modifier regions are rendered using the texture's current blend mode.
+    bool BlendTextureRegions(Texture& texture, std::vector<BlendTextureRegionJob>& jobs, TargetTexture& atlasTexture, int atlasWidth = 0);
+
+}
@@ -1,5 +1,10 @@
 
 #include "UpdateLoopScheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <SDL_video.h>
+#include "Window.h"
+#include "ErrorLogger.h"
 
 namespace pix
 {
@@ -20,9 +25,9 @@ namespace pix
 			return updatesPerSecond_;
 		}
 
-		float AbstractUpdateLoopScheduler::GetUpdatePeriod() const
+		double AbstractUpdateLoopScheduler::GetUpdatePeriod() const
 		{
-			return  1000.0f / updatesPerSecond_;
+			return  1000.0 / updatesPerSecond_;
 		}
 
 
@@ -33,13 +38,13 @@ namespace pix
 			if (maxUpdatesPerFrame_ < 1) maxUpdatesPerFrame_ = 1;
 		}
 
-		int StandardUpdateLoopScheduler::Update(float deltaTime)
+		int StandardUpdateLoopScheduler::Update(double deltaTime)
 		{
 			unprocessedTime_ += deltaTime;
 
-			const float updatePeriod = GetUpdatePeriod();
+			const double updatePeriod = GetUpdatePeriod();
 
-			const float maxUnprocessedTime = (maxUpdatesPerFrame_ + 2) * updatePeriod;
+			const double maxUnprocessedTime = (maxUpdatesPerFrame_ + 2) * updatePeriod;
 
 			int updateCount = 0;
 
@@ -54,7 +59,7 @@ namespace pix
 			return updateCount;
 		}
 
-		float StandardUpdateLoopScheduler::GetUnprocessedTime() const 
+		double StandardUpdateLoopScheduler::GetUnprocessedTime() const 
 		{
 			return unprocessedTime_;
 		}
@@ -62,29 +67,34 @@ namespace pix
 
 
 
-		HysteresisUpdateLoopScheduler::HysteresisUpdateLoopScheduler(float updatesPerSecond, float noiseWidth, int filterLength, int maxUpdatesPerFrame) : AbstractUpdateLoopScheduler(updatesPerSecond),
+		HysteresisUpdateLoopScheduler::HysteresisUpdateLoopScheduler(float updatesPerSecond, float noiseWidth, int filterLength, int maxUpdatesPerFrame, FilterMode filterMode) : AbstractUpdateLoopScheduler(updatesPerSecond),
 			noiseWidth_(noiseWidth),
 			filterLength_(filterLength),
-			maxUpdatesPerFrame_(maxUpdatesPerFrame)
+			maxUpdatesPerFrame_(maxUpdatesPerFrame),
+			filterMode_(filterMode)
 		{
-			if (noiseWidth_ < 0.0f) noiseWidth_ = 0.0f;
+			if (noiseWidth_ < 0.0) noiseWidth_ = 0.0;
 			if (filterLength_ < 1) filterLength_ = 1;
 			if (maxUpdatesPerFrame_ < 1) maxUpdatesPerFrame_ = 1;
 
-			thresholdOffset_ = 0.5f * noiseWidth_;
+			thresholdOffset_ = 0.5 * noiseWidth_;
+
+			if (filterMode_ != EMA)
+				deltaTimeSamples_.resize(filterLength_, 0.0);
 
-			deltaTimeSamples_.reserve(filterLength_);
+			if (filterMode_ == MEDIAN)
+				sortedDeltaTimeSamples_.reserve(filterLength_);
 		}
 
 
 
-		int HysteresisUpdateLoopScheduler::Update(float deltaTime)
+		int HysteresisUpdateLoopScheduler::Update(double deltaTime)
 		{
-			const float updatePeriod = GetUpdatePeriod();
+			const double updatePeriod = GetUpdatePeriod();
 
 			// Keep two additional update periods as buffer so that unprocessedTime_
 	        // is not truncated when maxUpdatesPerFrame_ updates are processed on schedule
-			const float maxUnprocessedTime = (maxUpdatesPerFrame_ + 2) * updatePeriod;
+			const double maxUnprocessedTime = (maxUpdatesPerFrame_ + 2) * updatePeriod;
 
 			if (deltaTime > maxUnprocessedTime) deltaTime = maxUnprocessedTime;
 
@@ -99,9 +109,9 @@ namespace pix
 			while (true)
 			{
 				if (IsValueInUpper(unprocessedTime_))
-					thresholdOffset_ = -0.5f * noiseWidth_;
+					thresholdOffset_ = -0.5 * noiseWidth_;
 				else if (IsValueInLower(unprocessedTime_))
-					thresholdOffset_ = 0.5f * noiseWidth_;
+					thresholdOffset_ = 0.5 * noiseWidth_;
 
 				if (unprocessedTime_ < updatePeriod + thresholdOffset_ || updateCount >= maxUpdatesPerFrame_)
 					break;
@@ -113,51 +123,323 @@ namespace pix
 			return updateCount;
 		}
 
-		float HysteresisUpdateLoopScheduler::GetUnprocessedTime() const 
+		double HysteresisUpdateLoopScheduler::GetUnprocessedTime() const 
 		{
 			return unprocessedTime_;
 		}
 
-		float HysteresisUpdateLoopScheduler::GetAverageDeltaTime() const
+		double HysteresisUpdateLoopScheduler::GetAverageDeltaTime() const
 		{
 			return averageDeltaTime_;
 		}
 
+		HysteresisUpdateLoopScheduler::FilterMode HysteresisUpdateLoopScheduler::GetFilterMode() const
+		{
+			return filterMode_;
+		}
+
 
 
-		bool HysteresisUpdateLoopScheduler::IsValueInUpper(float value) const
+		bool HysteresisUpdateLoopScheduler::IsValueInUpper(double value) const
 		{
-			return value >= GetUpdatePeriod() + 0.5f * noiseWidth_ &&
-				value < GetUpdatePeriod() + 2.5f * noiseWidth_;
+			return value >= GetUpdatePeriod() + 0.5 * noiseWidth_ &&
+				value < GetUpdatePeriod() + 2.5 * noiseWidth_;
 		}
 
-		bool HysteresisUpdateLoopScheduler::IsValueInLower(float value) const
+		bool HysteresisUpdateLoopScheduler::IsValueInLower(double value) const
 		{
-			return value > GetUpdatePeriod() - 2.5f * noiseWidth_ &&
-				value < GetUpdatePeriod() - 0.5f * noiseWidth_;
+			return value > GetUpdatePeriod() - 2.5 * noiseWidth_ &&
+				value < GetUpdatePeriod() - 0.5 * noiseWidth_;
 		}
 
-		void HysteresisUpdateLoopScheduler::UpdateAverageDeltaTime(float newDeltaTime)
+		void HysteresisUpdateLoopScheduler::UpdateAverageDeltaTime(double newDeltaTime)
 		{
-			// Add newDeltaTime to ring buffer:
-			if (deltaTimeSamples_.size() < filterLength_)
-				deltaTimeSamples_.push_back(newDeltaTime);
+			if (filterMode_ == EMA)
+			{
+				// Same smoothing as a moving average of filterLength_ samples; the first sample initializes the average
+				const double smoothingFactor = 2.0 / (filterLength_ + 1);
+
+				if (sampleCount_ == 0)
+				{
+					averageDeltaTime_ = newDeltaTime;
+					sampleCount_ = 1;
+				}
+				else
+				{
+					averageDeltaTime_ += smoothingFactor * (newDeltaTime - averageDeltaTime_);
+				}
+
+				return;
+			}
+
+			// Add newDeltaTime to ring buffer, replacing the oldest sample once the buffer is full:
+			const bool isFull = sampleCount_ == filterLength_;
+			const double oldDeltaTime = deltaTimeSamples_[sampleIndex_];
+
+			deltaTimeSamples_[sampleIndex_] = newDeltaTime;
+			sampleIndex_++;
+			if (sampleIndex_ >= filterLength_)
+				sampleIndex_ = 0;
+
+			if (!isFull)
+				sampleCount_++;
+
+			if (filterMode_ == MEDIAN)
+			{
+				if (isFull)
+				{
+					UpdateSortedDeltaTimeSamples(oldDeltaTime, newDeltaTime);
+				}
+				else
+				{
+					sortedDeltaTimeSamples_.insert(std::upper_bound(sortedDeltaTimeSamples_.begin(), sortedDeltaTimeSamples_.end(), newDeltaTime), newDeltaTime);
+				}
+
+				const int middleIndex = sampleCount_ / 2;
+
+				averageDeltaTime_ = sampleCount_ % 2 == 1 ? sortedDeltaTimeSamples_[middleIndex] :
+					0.5 * (sortedDeltaTimeSamples_[middleIndex - 1] + sortedDeltaTimeSamples_[middleIndex]);
+
+				return;
+			}
+
+			// Update the running sum instead of summing the whole ring buffer:
+			if (isFull)
+				AddToDeltaTimeSum(-oldDeltaTime);
+
+			AddToDeltaTimeSum(newDeltaTime);
+
+			averageDeltaTime_ = deltaTimeSum_ / sampleCount_;
+		}
+
+		void HysteresisUpdateLoopScheduler::AddToDeltaTimeSum(double value)
+		{
+			const double compensatedValue = value - deltaTimeSumCompensation_;
+			const double newSum = deltaTimeSum_ + compensatedValue;
+
+			// Recovers the low-order bits of compensatedValue that were lost in the addition
+			deltaTimeSumCompensation_ = (newSum - deltaTimeSum_) - compensatedValue;
+			deltaTimeSum_ = newSum;
+		}
+
+		void HysteresisUpdateLoopScheduler::UpdateSortedDeltaTimeSamples(double oldValue, double newValue)
+		{
+			auto oldIt = std::lower_bound(sortedDeltaTimeSamples_.begin(), sortedDeltaTimeSamples_.end(), oldValue);
+
+			// Shift the samples between the old and the new position by one and write newValue into the gap
+			if (newValue > oldValue)
+			{
+				auto newIt = std::upper_bound(oldIt, sortedDeltaTimeSamples_.end(), newValue);
+				std::move(oldIt + 1, newIt, oldIt);
+				*(newIt - 1) = newValue;
+			}
 			else
 			{
-				deltaTimeSamples_[sampleIndex_] = newDeltaTime;
-				sampleIndex_++;
-				if (sampleIndex_ >= deltaTimeSamples_.size())
-					sampleIndex_ = 0;
+				auto newIt = std::upper_bound(sortedDeltaTimeSamples_.begin(), oldIt, newValue);
+				std::move_backward(newIt, oldIt, oldIt + 1);
+				*newIt = newValue;
+			}
+		}
+
+
+
+		AdaptiveUpdateLoopScheduler::AdaptiveUpdateLoopScheduler(float updatesPerSecond, int maxUpdatesPerFrame, float lockTolerance, int overloadFrameCount) : AbstractUpdateLoopScheduler(updatesPerSecond),
+			maxUpdatesPerFrame_(maxUpdatesPerFrame),
+			overloadFrameCount_(overloadFrameCount),
+			targetUpdatesPerSecond_(GetUpdatesPerSecond()),
+			lockTolerance_(lockTolerance)
+		{
+			if (maxUpdatesPerFrame_ < 1) maxUpdatesPerFrame_ = 1;
+			if (overloadFrameCount_ < 1) overloadFrameCount_ = 1;
+			if (lockTolerance_ < 0.0f) lockTolerance_ = 0.0f;
+
+			RefreshDisplayRate();
+		}
+
+		int AdaptiveUpdateLoopScheduler::Update(double deltaTime)
+		{
+			if (deltaTime < 0.0) deltaTime = 0.0;
+
+			displayQueryTime_ += deltaTime;
+
+			if (displayQueryTime_ >= DISPLAY_QUERY_PERIOD)
+				RefreshDisplayRate();
+
+			MeasureRefreshPeriod(deltaTime);
+
+			// While locked, snap deltas close to whole refresh periods, so timer noise does not shift updates between frames.
+			// The grid is an exact multiple or fraction of the update period, so snapped deltas add up to whole updates.
+			if (isLocked_)
+			{
+				const double refreshPeriod = updatesPerRefresh_ * GetUpdatePeriod();
+				const double refreshPeriodCount = std::round(deltaTime / refreshPeriod);
+
+				if (refreshPeriodCount >= 1.0 && std::abs(deltaTime - refreshPeriodCount * refreshPeriod) <= SNAP_TOLERANCE * refreshPeriod)
+					deltaTime = refreshPeriodCount * refreshPeriod;
 			}
 
-			// Compute average delta time:
-			float deltaTimeSum = 0.0f;
-			const int sampleCount = deltaTimeSamples_.size();
+			unprocessedTime_ += deltaTime;
+
+			const double updatePeriod = GetUpdatePeriod();
 
-			for (int i = 0; i < sampleCount; i++)
-				deltaTimeSum += deltaTimeSamples_[i];
+			// While locked, a little slack keeps rounding errors of the snapped deltas from shifting an update into the next frame
+			const double updateThreshold = isLocked_ ? updatePeriod * (1.0 - 0.5 * lockTolerance_) : updatePeriod;
+
+			int updateCount = 0;
 
-			averageDeltaTime_ = deltaTimeSum / sampleCount;
+			while (unprocessedTime_ >= updateThreshold && updateCount < maxUpdatesPerFrame_)
+			{
+				updateCount++;
+				unprocessedTime_ -= updatePeriod;
+			}
+
+			if (unprocessedTime_ < 0.0) unprocessedTime_ = 0.0;
+
+			// Overload: drop the backlog that the next frame could not process either
+			if (unprocessedTime_ >= updatePeriod)
+			{
+				const double keptTime = std::fmod(unprocessedTime_, updatePeriod);
+
+				droppedTime_ += unprocessedTime_ - keptTime;
+				unprocessedTime_ = keptTime;
+
+				if (overloadedFrameCount_ < overloadFrameCount_) overloadedFrameCount_++;
+			}
+			else
+			{
+				overloadedFrameCount_ = 0;
+			}
+
+			return updateCount;
+		}
+
+		double AdaptiveUpdateLoopScheduler::GetUnprocessedTime() const
+		{
+			return unprocessedTime_;
+		}
+
+		void AdaptiveUpdateLoopScheduler::SetTargetUpdatesPerSecond(float updatesPerSecond)
+		{
+			SetUpdatesPerSecond(updatesPerSecond);
+			targetUpdatesPerSecond_ = GetUpdatesPerSecond();
+
+			UpdateLock();
+		}
+
+		void AdaptiveUpdateLoopScheduler::RefreshDisplayRate()
+		{
+			displayQueryTime_ = 0.0;
+
+			const int prevDisplayRefreshRate = displayRefreshRate_;
+			displayRefreshRate_ = 0;
+
+			SDL_Window* sdlWindow = Window::Get().GetSDLWindow();
+
+			if (sdlWindow)
+			{
+				const int displayIndex = SDL_GetWindowDisplayIndex(sdlWindow);
+
+				SDL_DisplayMode displayMode;
+
+				if (displayIndex < 0)
+					ErrorLogger::Get().LogSDLError("AdaptiveUpdateLoopScheduler::RefreshDisplayRate() - SDL_GetWindowDisplayIndex() failure");
+				else if (SDL_GetCurrentDisplayMode(displayIndex, &displayMode) != 0)
+					ErrorLogger::Get().LogSDLError("AdaptiveUpdateLoopScheduler::RefreshDisplayRate() - SDL_GetCurrentDisplayMode() failure");
+				else
+					displayRefreshRate_ = displayMode.refresh_rate; // 0 if unspecified, e.g. with the dummy video driver
+			}
+
+			// A new display or mode restarts the measurement from the reported rate
+			if (displayRefreshRate_ != prevDisplayRefreshRate)
+			{
+				measuredTimeSum_ = 0.0;
+				measuredPeriodCount_ = 0;
+			}
+
+			refreshPeriod_ = displayRefreshRate_ > 0 ? 1000.0 / displayRefreshRate_ : 0.0;
+
+			if (measuredPeriodCount_ >= MIN_MEASURED_PERIOD_COUNT)
+			{
+				const double measuredPeriod = measuredTimeSum_ / measuredPeriodCount_;
+
+				// Without vsync, frame deltas say nothing about the display, so implausible measurements are ignored
+				if (std::abs(1000.0 / measuredPeriod - displayRefreshRate_) <= MAX_MEASURED_RATE_DEVIATION)
+					refreshPeriod_ = measuredPeriod;
+			}
+
+			UpdateLock();
+		}
+
+		float AdaptiveUpdateLoopScheduler::GetTargetUpdatesPerSecond() const
+		{
+			return targetUpdatesPerSecond_;
+		}
+
+		int AdaptiveUpdateLoopScheduler::GetDisplayRefreshRate() const
+		{
+			return displayRefreshRate_;
+		}
+
+		double AdaptiveUpdateLoopScheduler::GetRefreshPeriod() const
+		{
+			return refreshPeriod_;
+		}
+
+		bool AdaptiveUpdateLoopScheduler::IsLocked() const
+		{
+			return isLocked_;
+		}
+
+		bool AdaptiveUpdateLoopScheduler::IsOverloaded() const
+		{
+			return overloadedFrameCount_ >= overloadFrameCount_;
+		}
+
+		double AdaptiveUpdateLoopScheduler::GetDroppedTime() const
+		{
+			return droppedTime_;
+		}
+
+
+
+		void AdaptiveUpdateLoopScheduler::MeasureRefreshPeriod(double deltaTime)
+		{
+			if (refreshPeriod_ <= 0.0) return;
+
+			const double refreshPeriodCount = std::round(deltaTime / refreshPeriod_);
+
+			if (refreshPeriodCount >= 1.0 && std::abs(deltaTime - refreshPeriodCount * refreshPeriod_) <= SNAP_TOLERANCE * refreshPeriod_)
+			{
+				measuredTimeSum_ += deltaTime;
+				measuredPeriodCount_ += (int)refreshPeriodCount;
+			}
+		}
+
+		void AdaptiveUpdateLoopScheduler::UpdateLock()
+		{
+			isLocked_ = false;
+			updatesPerRefresh_ = 1.0;
+			float updatesPerSecond = targetUpdatesPerSecond_;
+
+			if (refreshPeriod_ > 0.0 && lockTolerance_ > 0.0f)
+			{
+				const float refreshRate = (float)(1000.0 / refreshPeriod_);
+
+				// Several updates per refresh, or one update every several refreshes
+				const float updatesPerRefresh = std::round(targetUpdatesPerSecond_ / refreshRate);
+				const float refreshesPerUpdate = std::round(refreshRate / targetUpdatesPerSecond_);
+
+				const float lockedRate = updatesPerRefresh >= 1.0f ? refreshRate * updatesPerRefresh : refreshRate / refreshesPerUpdate;
+
+				if (std::abs(lockedRate - targetUpdatesPerSecond_) <= lockTolerance_ * targetUpdatesPerSecond_)
+				{
+					isLocked_ = true;
+					updatesPerSecond = lockedRate;
+					updatesPerRefresh_ = updatesPerRefresh >= 1.0f ? updatesPerRefresh : 1.0 / refreshesPerUpdate;
+				}
+			}
+
+			SetUpdatesPerSecond(updatesPerSecond);
 		}
 
 }
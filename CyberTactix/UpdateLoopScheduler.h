@@ -7,7 +7,8 @@ namespace pix
 	// Abstract base class for fixed-timestep update scheduling.
 	//
 	// Accumulates frame delta time and determines how many updates should be executed for the current frame.	
-	// All time values are expressed in milliseconds.		
+	// All time values are expressed in milliseconds, as double, so that sub-millisecond frame deltas from
+	// SDL_GetPerformanceCounter() are accumulated without quantization or float drift.
 	// The returned update count should be used by the game loop to invoke the fixed update logic this many times.
 	class AbstractUpdateLoopScheduler
 	{
@@ -19,17 +20,17 @@ namespace pix
 		virtual ~AbstractUpdateLoopScheduler() = default;
 
 		// Accumulates frame delta time and returns the number of updates to execute this frame.
-		virtual int Update(float deltaTime) = 0;
+		virtual int Update(double deltaTime) = 0;
 
 		void SetUpdatesPerSecond(float updatesPerSecond);
 
 		// Returns the remaining time that has not been simulated yet
-		virtual float GetUnprocessedTime() const = 0;
+		virtual double GetUnprocessedTime() const = 0;
 
 		float GetUpdatesPerSecond() const;
 			
 		// Returns the update period
-		float GetUpdatePeriod() const;
+		double GetUpdatePeriod() const;
 
 	private:
 
@@ -48,14 +49,14 @@ namespace pix
 		
 		~StandardUpdateLoopScheduler() override = default;
 
-		int Update(float deltaTime) override;
+		int Update(double deltaTime) override;
 
-		float GetUnprocessedTime() const override;
+		double GetUnprocessedTime() const override;
 
 	private:
 
-		int   maxUpdatesPerFrame_ = 2;
-		float unprocessedTime_ = 0.0f;
+		int    maxUpdatesPerFrame_ = 2;
+		double unprocessedTime_ = 0.0;
 	};
 
 
@@ -65,37 +66,149 @@ namespace pix
 	{
 	public:
 
+		// Filters applied to the frame deltas before they are accumulated. All of them cost O(1) per frame,
+		// except MEDIAN, which keeps a sorted copy of the window (binary search plus a short memmove, no allocation).
+		enum FilterMode
+		{
+			MEAN,   // Moving average over the last filterLength deltas
+			EMA,    // Exponential moving average with the smoothing of a filterLength moving average; no window needed
+			MEDIAN  // Moving median over the last filterLength deltas; rejects single outlier frames completely
+		};
+
 		// - updatesPerSecond defines the target update rate.
         // - noiseWidth defines the hysteresis band around the update threshold, in milliseconds.
         // - filterLength defines how many frame deltas are averaged.
         // - maxUpdatesPerFrame limits how many fixed updates may be executed during one rendered frame.
-		explicit HysteresisUpdateLoopScheduler(float updatesPerSecond, float noiseWidth = 0.5f, int filterLength = 60, int maxUpdatesPerFrame = 2);
+		// - filterMode selects how frame deltas are averaged.
+		explicit HysteresisUpdateLoopScheduler(float updatesPerSecond, float noiseWidth = 0.5f, int filterLength = 60, int maxUpdatesPerFrame = 2, FilterMode filterMode = MEAN);
 
 	    ~HysteresisUpdateLoopScheduler() override = default;
 
-		int Update(float deltaTime) override;
+		int Update(double deltaTime) override;
 		
-		float GetUnprocessedTime() const override;
+		double GetUnprocessedTime() const override;
 	
-		float GetAverageDeltaTime() const;
+		double GetAverageDeltaTime() const;
+
+		FilterMode GetFilterMode() const;
 
 	private:
 
-		bool IsValueInUpper(float value) const;
+		bool IsValueInUpper(double value) const;
 	
-		bool IsValueInLower(float value) const;
+		bool IsValueInLower(double value) const;
+
+		void UpdateAverageDeltaTime(double newDeltaTime);
+
+		// Kahan-compensated addition to deltaTimeSum_, so that the running sum does not drift over millions of frames
+		void AddToDeltaTimeSum(double value);
 
-		void UpdateAverageDeltaTime(float newDeltaTime);
+		// Replaces oldValue by newValue in sortedDeltaTimeSamples_, keeping it sorted
+		void UpdateSortedDeltaTimeSamples(double oldValue, double newValue);
 		
-		float noiseWidth_ = 0.5f; // defines the hysteresis band around the update threshold, in milliseconds.
-		int   filterLength_ = 60;
-		int   maxUpdatesPerFrame_ = 2;
-		float unprocessedTime_ = 0.0f;
-		float thresholdOffset_ = 0.25f;
-		float averageDeltaTime_ = 0.0f;
-		int   sampleIndex_ = 0; // For ring buffer implementation
-		std::vector<float> deltaTimeSamples_;
+		double noiseWidth_ = 0.5; // defines the hysteresis band around the update threshold, in milliseconds.
+		int    filterLength_ = 60;
+		int    maxUpdatesPerFrame_ = 2;
+		FilterMode filterMode_ = MEAN;
+		double unprocessedTime_ = 0.0;
+		double thresholdOffset_ = 0.25;
+		double averageDeltaTime_ = 0.0;
+		double deltaTimeSum_ = 0.0;          // Running sum of the samples in the ring buffer (MEAN)
+		double deltaTimeSumCompensation_ = 0.0;
+		int    sampleIndex_ = 0;             // For ring buffer implementation
+		int    sampleCount_ = 0;             // Valid samples in the ring buffer; less than filterLength_ during warm-up
+		std::vector<double> deltaTimeSamples_;       // Ring buffer, preallocated to filterLength_ (MEAN, MEDIAN)
+		std::vector<double> sortedDeltaTimeSamples_; // The valid samples in ascending order (MEDIAN)
+
+	};
+
+	// A fixed-timestep scheduler that adapts to the display refresh rate and to machine overload.
+	//
+	// Technical note:
+	// The refresh rate of the display showing the window is queried at construction and about once per second,
+	// so moving the window to another display is picked up.
+	// If the target update rate is within lockTolerance of an integer multiple or divisor of the refresh rate
+	// (e.g. 60 updates per second on a 59.94, 120 or 240 Hz display), the update rate is locked to that exact ratio and
+	// frame deltas close to whole refresh periods are snapped to them. Every frame then runs the same number of updates
+	// (or every n-th frame runs one), which removes the beat pattern of almost-equal rates. The simulation speed deviates
+	// from the target by at most lockTolerance.
+	// SDL reports refresh rates as integers (59 or 60 for a 59.94 Hz display), so the refresh period is measured as the mean
+	// of the frame deltas close to whole refresh periods, which requires vsync. The snapping grid is derived from the locked
+	// update period itself, so an inexact refresh period changes the simulation speed slightly but never adds or drops updates.
+	// If maxUpdatesPerFrame updates do not catch up, the backlog is dropped instead of carried over, so a slow machine
+	// runs the simulation in slow motion instead of spiraling into maxUpdatesPerFrame updates every frame.
+	// After overloadFrameCount consecutive frames like this, IsOverloaded() reports it until a frame catches up again.
+	//
+	// Usage:
+	// if (scheduler.IsOverloaded()) world.ReduceSimulationCost(); // e.g. fewer particles, cheaper AI
+	class AdaptiveUpdateLoopScheduler : public AbstractUpdateLoopScheduler
+	{
+	public:
+
+		// - updatesPerSecond defines the target update rate.
+		// - maxUpdatesPerFrame limits how many fixed updates may be executed during one rendered frame.
+		// - lockTolerance is the maximum relative deviation from updatesPerSecond for locking to the refresh rate; 0 disables locking.
+		// - overloadFrameCount defines after how many consecutive frames with dropped backlog the scheduler reports overload.
+		explicit AdaptiveUpdateLoopScheduler(float updatesPerSecond, int maxUpdatesPerFrame = 4, float lockTolerance = 0.02f, int overloadFrameCount = 30);
+
+		~AdaptiveUpdateLoopScheduler() override = default;
+
+		int Update(double deltaTime) override;
+
+		double GetUnprocessedTime() const override;
+
+		// Sets the target update rate and locks it to the display refresh rate again, if possible
+		void SetTargetUpdatesPerSecond(float updatesPerSecond);
+
+		// Queries the refresh rate of the window's display and updates the lock. Update() calls this periodically.
+		void RefreshDisplayRate();
+
+		// Returns the requested update rate; GetUpdatesPerSecond() returns the rate actually used, which differs while locked
+		float GetTargetUpdatesPerSecond() const;
+
+		// Returns the refresh rate of the window's display in Hz as reported by SDL, or 0 if it is unknown
+		int GetDisplayRefreshRate() const;
+
+		// Returns the measured refresh period of the window's display in milliseconds, or the reported one until enough frames were measured.
+		// Returns 0 if the refresh rate is unknown.
+		double GetRefreshPeriod() const;
+
+		// Returns true if the update rate is locked to an integer ratio of the display refresh rate
+		bool IsLocked() const;
+
+		// Returns true if the machine could not keep up with the update rate for overloadFrameCount consecutive frames
+		bool IsOverloaded() const;
+
+		// Returns the total simulation time dropped because of overload, in milliseconds
+		double GetDroppedTime() const;
+
+	private:
 
+		static constexpr double DISPLAY_QUERY_PERIOD = 1000.0;      // in milliseconds
+		static constexpr double SNAP_TOLERANCE = 0.2;               // Maximum deviation from a whole refresh period for snapping, relative to the refresh period
+		static constexpr int    MIN_MEASURED_PERIOD_COUNT = 120;    // Refresh periods to measure before the measured refresh period is used
+		static constexpr double MAX_MEASURED_RATE_DEVIATION = 1.0;  // Maximum deviation of the measured from the reported refresh rate, in Hz
+
+		// Adds deltaTime to the refresh period measurement if it is close to whole refresh periods
+		void MeasureRefreshPeriod(double deltaTime);
+
+		// Locks the update rate to the display refresh rate if they are close to an integer ratio
+		void UpdateLock();
+
+		int    maxUpdatesPerFrame_ = 4;
+		int    overloadFrameCount_ = 30;
+		float  targetUpdatesPerSecond_ = 60.0f;
+		float  lockTolerance_ = 0.02f;
+		int    displayRefreshRate_ = 0;
+		double refreshPeriod_ = 0.0;        // Measured refresh period, or the reported one during measurement
+		double measuredTimeSum_ = 0.0;      // Sum of the frame deltas close to whole refresh periods
+		int    measuredPeriodCount_ = 0;    // Number of refresh periods in measuredTimeSum_
+		double updatesPerRefresh_ = 1.0;    // Locked ratio; less than 1 if an update spans several refreshes
+		int    overloadedFrameCount_ = 0;  // Consecutive frames with dropped backlog
+		double unprocessedTime_ = 0.0;
+		double displayQueryTime_ = 0.0;    // Time since the last display query
+		double droppedTime_ = 0.0;
+		bool   isLocked_ = false;
 	};
 
 